@@ -0,0 +1,100 @@
+/**
+ * @file reduction_benchmark.cpp
+ * @brief sum/var の実行時間と誤差を to_vector 後の単純なループと比較する
+ * @note g++ -std=c++11 -O2 -pthread -I.. reduction_benchmark.cpp && ./a.out [行数]
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "data_frame.hpp"
+
+template<class F>
+static double measure(const F& func, double& result)
+{
+    const auto start = std::chrono::steady_clock::now();
+    result = func();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv)
+{
+    const int rows = argc > 1 ? std::atoi(argv[1]) : 2000000;
+    const std::string path = "reduction_benchmark.csv";
+    std::vector<long double> exact_values;
+    {
+        std::mt19937_64 engine(0);
+        std::uniform_real_distribution<double> distribution(0.0, 1.0);
+        std::ofstream ofs(path);
+        ofs << "x\n" << std::setprecision(17);
+        for(int i = 0; i < rows; i++)
+        {
+            const double x = 1e8 + distribution(engine);
+            exact_values.push_back(x);
+            ofs << x << "\n";
+        }
+    }
+    const auto df = DataFrame::read_csv(path);
+    std::remove(path.c_str());
+
+    long double exact_sum = 0.0L;
+    for(const auto& x : exact_values)
+        exact_sum += x;
+    const long double exact_mean = exact_sum / rows;
+    long double exact_m2 = 0.0L;
+    for(const auto& x : exact_values)
+        exact_m2 += (x - exact_mean) * (x - exact_mean);
+    const double exact_var = static_cast<double>(exact_m2 / (rows - 1));
+
+    double result;
+    std::cout << std::setprecision(6) << "rows: " << rows << std::endl;
+    std::cout << std::left << std::setw(28) << "method" << std::setw(12) << "time[ms]" << "relative error" << std::endl;
+
+    const auto report = [&](const std::string& name, const double& time, const double& value, const double& exact)
+    {
+        std::cout << std::left << std::setw(28) << name << std::setw(12) << time << std::fabs(value - exact) / std::fabs(exact) << std::endl;
+    };
+
+    // 単純なループ (to_vector で変換した後に1スレッドで加算)
+    double time = measure([&]()
+    {
+        const auto values = df["x"].to_vector<double>();
+        double sum = 0.0;
+        for(const auto& x : values)
+            sum += x;
+        return sum;
+    }, result);
+    report("naive sum", time, result, static_cast<double>(exact_sum));
+
+    time = measure([&]() { return df.sum(DataFrame::SEQUENTIAL)["x"].as<double>(); }, result);
+    report("sum (sequential)", time, result, static_cast<double>(exact_sum));
+    time = measure([&]() { return df.sum(DataFrame::PARALLEL)["x"].as<double>(); }, result);
+    report("sum (parallel)", time, result, static_cast<double>(exact_sum));
+
+    // 単純な1パスの分散 (二乗和 - 和の二乗)
+    time = measure([&]()
+    {
+        const auto values = df["x"].to_vector<double>();
+        double sum = 0.0, square = 0.0;
+        for(const auto& x : values)
+        {
+            sum    += x;
+            square += x * x;
+        }
+        return (square - sum * sum / rows) / (rows - 1);
+    }, result);
+    report("naive var", time, result, exact_var);
+
+    time = measure([&]() { return df.var(1, DataFrame::SEQUENTIAL)["x"].as<double>(); }, result);
+    report("var (sequential)", time, result, exact_var);
+    time = measure([&]() { return df.var(1, DataFrame::PARALLEL)["x"].as<double>(); }, result);
+    report("var (parallel)", time, result, exact_var);
+    return 0;
+}
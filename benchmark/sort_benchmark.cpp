@@ -0,0 +1,78 @@
+/**
+ * @file sort_benchmark.cpp
+ * @brief sort_values (基数ソート + 並列マージ) の実行時間を std::stable_sort / std::sort と比較する
+ * @note g++ -std=c++11 -O2 -pthread -I.. sort_benchmark.cpp && ./a.out [行数]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "data_frame.hpp"
+
+template<class F>
+static double measure(const F& func)
+{
+    const auto start = std::chrono::steady_clock::now();
+    func();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv)
+{
+    const int rows = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    const std::string path = "sort_benchmark.csv";
+    {
+        std::mt19937_64 engine(0);
+        std::uniform_real_distribution<double> distribution(-1000.0, 1000.0);
+        std::ofstream ofs(path);
+        ofs << "x,name\n";
+        for(int i = 0; i < rows; i++)
+            ofs << distribution(engine) << ",n" << (engine() % 1000) << "\n";
+    }
+    const auto df = DataFrame::read_csv(path);
+    std::remove(path.c_str());
+
+    std::cout << "rows: " << rows << std::endl;
+    std::cout << std::left << std::setw(36) << "method" << "time[ms]" << std::endl;
+    const auto report = [](const std::string& name, const double& time)
+    {
+        std::cout << std::left << std::setw(36) << name << time << std::endl;
+    };
+
+    // 行をコピーし、比較のたびに数値へ変換して並べ替える
+    report("std::stable_sort (numeric)", measure([&]()
+    {
+        auto data = df.data();
+        std::stable_sort(data.begin(), data.end(), [](const std::vector<std::string>& a, const std::vector<std::string>& b) { return std::stod(a[0]) < std::stod(b[0]); });
+    }));
+    report("std::sort (numeric, parsed once)", measure([&]()
+    {
+        const auto data = df.data();
+        std::vector<std::pair<double, std::size_t>> keys(data.size());
+        for(std::size_t r = 0; r < data.size(); r++)
+            keys[r] = std::make_pair(std::stod(data[r][0]), r);
+        std::sort(keys.begin(), keys.end());
+        std::vector<std::vector<std::string>> sorted;
+        sorted.reserve(data.size());
+        for(const auto& key : keys)
+            sorted.push_back(data[key.second]);
+    }));
+    report("sort_values (numeric, sequential)", measure([&]() { df.sort_values({"x"}, true, DataFrame::SEQUENTIAL); }));
+    report("sort_values (numeric, parallel)", measure([&]() { df.sort_values({"x"}, true, DataFrame::PARALLEL); }));
+
+    report("std::stable_sort (string)", measure([&]()
+    {
+        auto data = df.data();
+        std::stable_sort(data.begin(), data.end(), [](const std::vector<std::string>& a, const std::vector<std::string>& b) { return a[1] < b[1]; });
+    }));
+    report("sort_values (string, sequential)", measure([&]() { df.sort_values({"name"}, true, DataFrame::SEQUENTIAL); }));
+    report("sort_values (string, parallel)", measure([&]() { df.sort_values({"name"}, true, DataFrame::PARALLEL); }));
+    return 0;
+}
@@ -22,6 +22,19 @@
 #include <initializer_list>     // std::initilizer_list
 #include <utility>              // std::tuple
 #include <unordered_map>
+#include <thread>               // std::thread
+#include <exception>            // std::exception_ptr, std::current_exception, std::rethrow_exception
+#include <cstdlib>              // std::strtod
+#include <limits>               // std::numeric_limits
+#include <iomanip>              // std::setprecision
+#include <cmath>                // std::sqrt
+#include <cstdint>              // std::uint64_t
+#include <cstring>              // std::memcpy
+#include <iterator>             // std::back_inserter
+#include <memory>               // std::shared_ptr
+#include <type_traits>          // std::enable_if, std::is_arithmetic
+#include <deque>                // std::deque
+#include <map>                  // std::map
 
 /**
  * @class DataFrame
@@ -54,6 +67,97 @@ public:
         AUTO_TRIM
     };
 
+    enum Layout
+    {
+        ROW_MAJOR,
+        COLUMN_MAJOR
+    };
+
+    enum Execution
+    {
+        AUTO,
+        SEQUENTIAL,
+        PARALLEL
+    };
+
+    enum Join
+    {
+        INNER,
+        LEFT,
+        RIGHT,
+        OUTER,
+        SEMI,
+        ANTI
+    };
+
+    enum Compare
+    {
+        EQUAL,
+        NOT_EQUAL,
+        LESS,
+        LESS_EQUAL,
+        GREATER,
+        GREATER_EQUAL
+    };
+
+    enum JoinAlgorithm
+    {
+        AUTO_JOIN,
+        HASH_JOIN,
+        SORT_MERGE_JOIN
+    };
+
+    enum Aggregation
+    {
+        SUM,
+        MEAN,
+        COUNT,
+        MIN,
+        MAX,
+        FIRST,
+        LAST
+    };
+
+    enum Keep
+    {
+        KEEP_FIRST,
+        KEEP_LAST,
+        KEEP_NONE
+    };
+
+    enum Decay
+    {
+        ALPHA,
+        SPAN,
+        COM,
+        HALFLIFE
+    };
+
+    /**
+     * @struct MemoryUsage
+     * @brief @ref memory_usage の結果を保持する構造体
+     */
+    struct MemoryUsage
+    {
+        std::vector<std::string> column;        //!< 列名
+        std::vector<std::size_t> inline_bytes;  //!< 列ごとの std::string オブジェクト自体のバイト数
+        std::vector<std::size_t> heap_bytes;    //!< 列ごとの文字列ヒープ領域のバイト数 (deep指定時のみ計上)
+        std::size_t container_bytes;            //!< 行コンテナ・ヘッダー等、列に属さない領域のバイト数
+        std::size_t overhead_bytes;             //!< アロケータの管理領域・アラインメントによる余剰の推定バイト数
+
+        /**
+         * @fn total
+         * @brief DataFrame全体の使用バイト数を返す
+         */
+        std::size_t total() const
+        {
+            std::size_t result = container_bytes + overhead_bytes;
+            for(std::size_t i = 0; i < column.size(); i++)
+                result += inline_bytes[i] + heap_bytes[i];
+            return result;
+        }
+    };
+
     class DynamicType
     {
     private:
@@ -156,483 +260,5094 @@ public:
     };
 
     /**
-     * @fn operator=
-     * @brief コピーメソッド
-     * 
-     * @param DataFrame  
+     * @class Mask
+     * @brief 行の選択結果を保持するクラス (選択された行インデックスを昇順に保持する)
+     * @note 比較演算子 (df["col"] > 500.0 等) で生成し、@ref filter に渡して行を取り出す。
      */
-    void operator=(const DataFrame& other)
+    class Mask
     {
-        header_ = other.header_;
-        data_   = other.data_;
-    }
+    public:
+        /**
+         * @brief 行ごとの真偽値から生成するコンストラクタ
+         * 
+         * @param std::vector<bool> flags 各行を選択するか
+         */
+        explicit Mask(const std::vector<bool>& flags)
+        : size_(flags.size()), indices_()
+        {
+            for(std::size_t r = 0; r < flags.size(); r++)
+                if(flags[r])
+                    indices_.push_back(r);
+        }
 
-    /**
-     * @fn read_csv
-     * @brief CSV読取メソッド (Factory Method)
-     * 
-     * @param std::string file_path csvのファイルパス
-     * @param 
-     * @return DataFrame 読取後DataFrameインスタンス
-     */
-    static DataFrame read_csv(const std::string& file_path, const std::unordered_map<ReadCsvArgument, DynamicType>& arg_map)
-    {
-        const auto header       = arg_map.count(HEADER)    ? arg_map.at(HEADER).as<bool>()           : true;
-        const auto separator    = arg_map.count(SEPARATOR) ? arg_map.at(SEPARATOR).as<std::string>()  : ",";
-        const auto new_line     = arg_map.count(NEW_LINE)  ? arg_map.at(NEW_LINE).as<std::string>()  : "\n";
-        const auto auto_trim    = arg_map.count(AUTO_TRIM) ? arg_map.at(AUTO_TRIM).as<bool>()        : true;
-        return read_csv(file_path, header, separator, new_line, auto_trim);
-    }
+        Mask operator&(const Mask& other) const
+        {
+            check_size(other);
+            std::vector<std::size_t> result;
+            std::set_intersection(indices_.begin(), indices_.end(), other.indices_.begin(), other.indices_.end(), std::back_inserter(result));
+            return Mask(size_, std::move(result));
+        }
 
-    /**
-     * @fn read_csv
-     * @brief CSV読取メソッド (Factory Method)
-     * 
-     * @param std::string file_path csvのファイルパス
-     * @param 
-     * @return DataFrame 読取後DataFrameインスタンス
-     */
-#ifdef __unix__
-    static DataFrame read_csv(const std::string& file_path, const bool& header=true, const std::string& separator = ",", const std::string& new_line =   "\n", const bool& auto_trim = true)
-#else
-    static DataFrame read_csv(const std::string& file_path, const bool& header=true, const std::string& separator = ",", const std::string& new_line = "\r\n", const bool& auto_trim = true)
-#endif
-    {
-        std::vector<std::string> header_row;
-        std::vector<std::vector<std::string>> data;
+        Mask operator|(const Mask& other) const
+        {
+            check_size(other);
+            std::vector<std::size_t> result;
+            std::set_union(indices_.begin(), indices_.end(), other.indices_.begin(), other.indices_.end(), std::back_inserter(result));
+            return Mask(size_, std::move(result));
+        }
 
-        std::ifstream ifs(file_path, std::ios_base::binary);
-        if(!ifs)
-            throw std::runtime_error("file '" + file_path + "' doesn't exist.");
+        Mask operator~() const
+        {
+            std::vector<std::size_t> result;
+            result.reserve(size_ - indices_.size());
+            auto itr = indices_.begin();
+            for(std::size_t r = 0; r < size_; r++)
+            {
+                if(itr != indices_.end() && *itr == r)
+                    itr++;
+                else
+                    result.push_back(r);
+            }
+            return Mask(size_, std::move(result));
+        }
 
-        std::stringstream ss;
-        ss << ifs.rdbuf();
-        std::string buffer = ss.str();
-        auto line_list = split(buffer, new_line);
-        while(line_list.back().empty())
-            line_list.pop_back();
+        /**
+         * @fn size
+         * @brief 対象のDataFrameの行数を返す
+         */
+        std::size_t size() const
+        {
+            return size_;
+        }
 
-        // switching header on/off.
-        if(header)
+        /**
+         * @fn count
+         * @brief 選択された行数を返す
+         */
+        std::size_t count() const
         {
-            header_row = split(line_list.front(), separator, auto_trim);
-            line_list.erase(line_list.begin());
+            return indices_.size();
         }
-        else
+
+        /**
+         * @fn indices
+         * @brief 選択された行インデックスを昇順で返す
+         */
+        const std::vector<std::size_t>& indices() const
         {
-            for(auto i=0; i < split(line_list.front(), separator, auto_trim).size();i++) 
-                header_row.push_back(std::to_string(i));
+            return indices_;
         }
 
-        int row_index = 0;
-        data.reserve(line_list.size());
-        for(auto&& line : line_list)
+    private:
+        friend class DataFrame;
+
+        Mask(const std::size_t& size, std::vector<std::size_t>&& indices)
+        : size_(size), indices_(std::move(indices))
+        {}
+
+        void check_size(const Mask& other) const
         {
-            auto row = split(line, separator, auto_trim);
-            if(row.size() != header_row.size())
-            {
-                std::stringstream ss;
-                ss  << "line[" << row_index + static_cast<int>(header) << "] element size between header and row is different."
-                    << "header's element size : " << header_row.size() << "row's element size : " << row.size();  
-                throw std::runtime_error(ss.str());
-            }
-            data.push_back(row);
-            row_index++;
+            if(size_ != other.size_)
+                throw std::runtime_error("mask size is different.");
         }
 
-        return DataFrame(header_row, std::move(data));
-    }
+        std::size_t size_;
+        std::vector<std::size_t> indices_;
+    };
 
     /**
-     * @fn to_csv
-     * @brief csvファイルへの書込メソッド
-     * 
-     * @param std::stirng file_path 書込先ファイルパス 
-     * @param append 追記モードか、上書きモードか
-     * @param header ヘッダーを出力データに含めるか
-     * @param separator 区切り文字
+     * @class Expression
+     * @brief 列の四則演算を表す式テンプレートの基底クラス
+     * @note df["a"] * 2.0 + df["b"] / df["c"] のような演算は演算子ごとに中間の列を作らず、式の木をコンパイル時に組み立てる。
+     * @n    評価時に全要素を1回のループで計算するため、コンパイラの自動ベクトル化が効く。
+     * @n    数値に変換できない要素はNaNとして扱う。
      */
-    void to_csv(const std::string& file_path, const bool& append=false, const bool& header=true, const std::string& separator=",") const
+    template<typename E>
+    class Expression
     {
-        std::ofstream ofs;
-        append ? ofs.open(file_path, std::ios::app) : ofs.open(file_path); // switching append or overwrite.
-        if(!ofs) 
-            throw std::runtime_error("file path '" + file_path + "' doesn't exist.");
+    public:
+        std::size_t size() const
+        {
+            return static_cast<const E&>(*this).size();
+        }
 
-        if(header)
-            ofs << concat(header_, separator) << std::endl;
-        
-        std::stringstream ss;
-        for (const auto& row : data_)
-            ss << concat(row, separator) << std::endl;
-        
-        auto result = ss.str();
-        
-        result.pop_back(); // pop back latest new line
-        ofs << result;
-    }
+        /**
+         * @fn evaluate
+         * @brief 式を評価して結果をベクターで返す
+         */
+        std::vector<double> evaluate() const
+        {
+            const E& expression = static_cast<const E&>(*this);
+            std::vector<double> result(expression.size());
+            double* out = result.data();
+            const std::size_t n = result.size();
+            for(std::size_t i = 0; i < n; i++)
+                out[i] = expression[i];
+            return result;
+        }
 
+        operator std::vector<double>() const
+        {
+            return evaluate();
+        }
+    };
 
     /**
-     * @fn operator[]
-     * @brief 列名によるDataFrameの切出メソッド
-     * 
-     * @param std::stirng target_column 取得対象の列名
-     * @return DataFrame 切出処理後の新たなDataFrameインスタンス
+     * @class ColumnExpression
+     * @brief 式の葉となる列 (1列のDataFrameを数値の連続領域に変換して保持する)
      */
-    DataFrame operator[](const std::string& target_column) const
+    class ColumnExpression : public Expression<ColumnExpression>
     {
-        auto itr = std::find(header_.begin(), header_.end(), target_column);
-        
-        if (itr==header_.end())
+    public:
+        explicit ColumnExpression(const DataFrame& frame)
+        : values_(), data_(), size_()
         {
-            std::stringstream ss;
-            ss << "target column '" << target_column << "' was not found.";
-            throw std::runtime_error(ss.str());
+            if(frame.header_.size() != 1)
+                throw std::runtime_error("column arithmetic can be used to 1 column DataFrame only.");
+            auto values = std::make_shared<std::vector<double>>(frame.data_.size());
+            for(std::size_t r = 0; r < frame.data_.size(); r++)
+                if(!to_number(frame.data_[r][0], (*values)[r]))
+                    (*values)[r] = std::numeric_limits<double>::quiet_NaN();
+            values_ = values;
+            data_   = values_->data();
+            size_   = values_->size();
         }
 
-        int index = std::distance(header_.begin(), itr);
-        std::vector<std::string> header = {header_.at(index)};
-        std::vector<std::vector<std::string>> data;
+        double operator[](const std::size_t& i) const
+        {
+            return data_[i];
+        }
 
-        for(const auto& row : data_)
-            data.push_back({row.at(index)});
+        std::size_t size() const
+        {
+            return size_;
+        }
 
-        return DataFrame(header, std::move(data));
-    }
+    private:
+        std::shared_ptr<const std::vector<double>> values_;
+        const double* data_;
+        std::size_t size_;
+    };
 
     /**
-     * @fn operator[]
-     * @brief 列名によるDataFrameの切出メソッド
-     * 
-     * @param std::stirng target_column 取得対象の列名
-     * @return DataFrame 切出処理後の新たなDataFrameインスタンス
+     * @class ScalarExpression
+     * @brief 式の葉となる定数 (全要素に同じ値を用いる)
      */
-    DataFrame operator[](const char* target_column) const
+    class ScalarExpression : public Expression<ScalarExpression>
     {
-        return this->operator[](std::string(target_column));
-    }
+    public:
+        explicit ScalarExpression(const double& value)
+        : value_(value)
+        {}
+
+        double operator[](const std::size_t&) const
+        {
+            return value_;
+        }
+
+        std::size_t size() const
+        {
+            return 0;
+        }
+
+    private:
+        double value_;
+    };
 
     /**
-     * @fn operator[]
-     * @brief 列名によるDataFrameの切出メソッド
-     * 
-     * @param std::vector<std::stirng> target_column_list 取得対象の列名のリスト
-     * @return DataFrame 切出処理後の新たなDataFrameインスタンス
+     * @class BinaryExpression
+     * @brief 2項演算の節
      */
-    DataFrame operator[](const std::vector<std::string>& target_column_list) const
+    template<typename Op, typename L, typename R>
+    class BinaryExpression : public Expression<BinaryExpression<Op, L, R>>
     {
-        std::vector<int> indices;
-        for (const auto& column : target_column_list)
+    public:
+        BinaryExpression(const L& left, const R& right)
+        : left_(left), right_(right), size_((std::max)(left.size(), right.size()))
         {
-            auto itr = std::find(header_.begin(), header_.end(), column);
-            if (itr==header_.end())
-                throw std::runtime_error("target column was not found.");
-            int index = std::distance(header_.begin(), itr);
-            indices.push_back(index);
+            if(left.size() && right.size() && left.size() != right.size())
+                throw std::runtime_error("row size of column arithmetic operands is different.");
         }
 
-        std::vector<std::string> header;
-        for(const auto& index : indices)
-            header.push_back(header_[index]);
+        double operator[](const std::size_t& i) const
+        {
+            return Op::apply(left_[i], right_[i]);
+        }
 
-        std::vector<std::string> row_data;
-        std::vector<std::vector<std::string>> data;
-        for(const auto& row : data_)
+        std::size_t size() const
         {
-            row_data.clear();
-            for(const auto& index : indices)
-                row_data.push_back(row[index]);
-            data.push_back(row_data);
+            return size_;
         }
 
-        return DataFrame(header, std::move(data));
-    }
+    private:
+        L left_;
+        R right_;
+        std::size_t size_;
+    };
+
+    struct Plus     { static double apply(const double& a, const double& b) { return a + b; } };
+    struct Minus    { static double apply(const double& a, const double& b) { return a - b; } };
+    struct Multiply { static double apply(const double& a, const double& b) { return a * b; } };
+    struct Divide   { static double apply(const double& a, const double& b) { return a / b; } };
 
     /**
-     * @fn operator[]
-     * @brief 行インデックスによるDataFrameの切出メソッド
-     * 
-     * @param std::stirng target_row 取得対象の行インデックス
-     * @return DataFrame 切出処理後の新たなDataFrameインスタンス
-     * @note 負数を指定した場合の取得対象行のインデックスはpandasの仕様に従う。
-     * @n    --例--  df[-1] == df[0] ... true
+     * @struct Operand
+     * @brief 演算子の被演算子を式の節に変換する (DataFrame -> 列, 算術型 -> 定数, 式 -> そのまま)
      */
-    DataFrame operator[](const int& target_row) const
+    template<typename T, typename = void>
+    struct Operand
     {
-        int index;
-        index = target_row >= 0 ? target_row : data_.size() + target_row;
-        if (index < 0 || index >= data_.size())
-            throw std::out_of_range("index number [" + std::to_string(target_row) + "] was out of range");
+        static const bool valid = false;
+    };
 
-        return DataFrame(header_, {data_[index]});
-    }
+    template<typename T>
+    struct Operand<T, typename std::enable_if<std::is_same<T, DataFrame>::value>::type>
+    {
+        static const bool valid = true;
+        typedef ColumnExpression type;
+        static type make(const DataFrame& frame) { return ColumnExpression(frame); }
+    };
+
+    template<typename T>
+    struct Operand<T, typename std::enable_if<std::is_arithmetic<T>::value>::type>
+    {
+        static const bool valid = true;
+        typedef ScalarExpression type;
+        static type make(const T& value) { return ScalarExpression(static_cast<double>(value)); }
+    };
+
+    template<typename T>
+    struct Operand<T, typename std::enable_if<std::is_base_of<Expression<T>, T>::value>::type>
+    {
+        static const bool valid = true;
+        typedef T type;
+        static const type& make(const T& expression) { return expression; }
+    };
 
     /**
-     * @fn slice
+     * @struct BinaryResult
+     * @brief 2項演算の結果の型 (被演算子が列・式を含まない場合は type を持たず、演算子の候補から外れる)
+     */
+    template<typename Op, typename L, typename R, bool = Operand<L>::valid && Operand<R>::valid && !(std::is_arithmetic<L>::value && std::is_arithmetic<R>::value)>
+    struct BinaryResult
+    {};
+
+    template<typename Op, typename L, typename R>
+    struct BinaryResult<Op, L, R, true>
+    {
+        typedef BinaryExpression<Op, typename Operand<L>::type, typename Operand<R>::type> type;
+    };
+
+    template<typename L, typename R>
+    friend typename BinaryResult<Plus, L, R>::type operator+(const L& left, const R& right)
+    {
+        return typename BinaryResult<Plus, L, R>::type(Operand<L>::make(left), Operand<R>::make(right));
+    }
+
+    template<typename L, typename R>
+    friend typename BinaryResult<Minus, L, R>::type operator-(const L& left, const R& right)
+    {
+        return typename BinaryResult<Minus, L, R>::type(Operand<L>::make(left), Operand<R>::make(right));
+    }
+
+    template<typename L, typename R>
+    friend typename BinaryResult<Multiply, L, R>::type operator*(const L& left, const R& right)
+    {
+        return typename BinaryResult<Multiply, L, R>::type(Operand<L>::make(left), Operand<R>::make(right));
+    }
+
+    template<typename L, typename R>
+    friend typename BinaryResult<Divide, L, R>::type operator/(const L& left, const R& right)
+    {
+        return typename BinaryResult<Divide, L, R>::type(Operand<L>::make(left), Operand<R>::make(right));
+    }
+
+    /**
+     * @class QuantileSketch
+     * @brief 近似分位点を求めるためのマージ可能なスケッチ (KLL)
+     * @note 要素数によらず保持する要素数は概ね 3k 個 (k=200 で数KB) に抑えられ、順位の誤差は概ね 1.7 / k 程度となる。
+     * @n    各レベルの要素は 2^レベル の重みを持ち、容量を超えたレベルは並べ替えて1つおきに上位レベルへ昇格させる。
+     * @n    昇格させる要素の選択には固定シードの xorshift を用いるため、同じ入力順であれば結果は再現する。
+     * @n    @ref merge でスレッド間やバッチ間のスケッチを統合できる。
+     */
+    class QuantileSketch
+    {
+    public:
+        /**
+         * @brief コンストラクタ
+         * 
+         * @param std::size_t k 精度パラメータ (大きいほど高精度で、保持する要素数が増える)
+         */
+        explicit QuantileSketch(const std::size_t& k=200)
+        : k_(std::max<std::size_t>(k, 8)), count_(0), size_(0), limit_(0), random_(0x9E3779B97F4A7C15ULL), 
+          min_(std::numeric_limits<double>::infinity()), max_(-std::numeric_limits<double>::infinity()), levels_(1)
+        {
+            limit_ = total_capacity();
+        }
+
+        /**
+         * @fn update
+         * @brief 値を1つ追加する (NaN は無視する)
+         */
+        void update(const double& value)
+        {
+            if(value != value)
+                return;
+            levels_[0].push_back(value);
+            count_++;
+            size_++;
+            min_ = (std::min)(min_, value);
+            max_ = (std::max)(max_, value);
+            if(size_ > limit_)
+                compress();
+        }
+
+        /**
+         * @fn merge
+         * @brief 他のスケッチの内容を統合する
+         */
+        void merge(const QuantileSketch& other)
+        {
+            if(other.levels_.size() > levels_.size())
+            {
+                levels_.resize(other.levels_.size());
+                limit_ = total_capacity();
+            }
+            for(std::size_t h = 0; h < other.levels_.size(); h++)
+                levels_[h].insert(levels_[h].end(), other.levels_[h].begin(), other.levels_[h].end());
+            count_ += other.count_;
+            size_  += other.size_;
+            min_ = (std::min)(min_, other.min_);
+            max_ = (std::max)(max_, other.max_);
+            compress();
+        }
+
+        /**
+         * @fn quantile
+         * @brief 分位点 q (0 <= q <= 1) の近似値を返す (空の場合は NaN)
+         * @note 重み付きの順位が q に達する要素を返す。(最小値・最大値は厳密値)
+         */
+        double quantile(const double& q) const
+        {
+            if(count_ == 0)
+                return std::numeric_limits<double>::quiet_NaN();
+            if(q <= 0.0)
+                return min_;
+            if(q >= 1.0)
+                return max_;
+
+            std::vector<std::pair<double, std::uint64_t>> items;
+            items.reserve(size_);
+            std::uint64_t total = 0;
+            for(std::size_t h = 0; h < levels_.size(); h++)
+            {
+                for(const auto& value : levels_[h])
+                    items.push_back(std::make_pair(value, std::uint64_t(1) << h));
+                total += static_cast<std::uint64_t>(levels_[h].size()) << h;
+            }
+            std::sort(items.begin(), items.end());
+            const double target = q * total;
+            std::uint64_t weight = 0;
+            for(const auto& item : items)
+            {
+                weight += item.second;
+                if(weight > target)
+                    return item.first;
+            }
+            return items.back().first;
+        }
+
+        /**
+         * @fn count
+         * @brief 追加された値の個数を返す
+         */
+        std::uint64_t count() const
+        {
+            return count_;
+        }
+
+        /**
+         * @fn size
+         * @brief 保持している要素数を返す
+         */
+        std::size_t size() const
+        {
+            return size_;
+        }
+
+    private:
+        std::size_t capacity(const std::size_t& level) const
+        {
+            const double depth = static_cast<double>(levels_.size() - 1 - level);
+            return std::max<std::size_t>(2, static_cast<std::size_t>(k_ * std::pow(2.0 / 3.0, depth)));
+        }
+
+        std::size_t total_capacity() const
+        {
+            std::size_t total = 0;
+            for(std::size_t h = 0; h < levels_.size(); h++)
+                total += capacity(h);
+            return total;
+        }
+
+        /**
+         * @fn compress
+         * @brief 全体の容量を超えている間、容量に達した最下位のレベルを圧縮する
+         */
+        void compress()
+        {
+            while(size_ > limit_)
+            {
+                std::size_t h = 0;
+                while(levels_[h].size() < capacity(h))
+                    h++;
+                if(h + 1 == levels_.size())
+                {
+                    levels_.emplace_back();
+                    limit_ = total_capacity();
+                }
+
+                auto& level = levels_[h];
+                std::sort(level.begin(), level.end());
+                random_ ^= random_ << 13;
+                random_ ^= random_ >> 7;
+                random_ ^= random_ << 17;
+                const std::size_t offset = random_ & 1;
+                const std::size_t paired = level.size() & ~std::size_t(1);
+                for(std::size_t i = offset; i < paired; i += 2)
+                    levels_[h + 1].push_back(level[i]);
+                // an odd element stays at this level
+                level.erase(level.begin(), level.begin() + paired);
+                size_ -= paired / 2;
+            }
+        }
+
+        std::size_t k_;
+        std::uint64_t count_;
+        std::size_t size_;
+        std::size_t limit_;     //!< 全レベルの容量の合計
+        std::uint64_t random_;
+        double min_;
+        double max_;
+        std::vector<std::vector<double>> levels_;
+    };
+
+    /**
+     * @class DistinctSketch
+     * @brief 異なり数を近似するためのマージ可能なスケッチ (HyperLogLog)
+     * @note 2^precision 個の1バイトのレジスタを持ち (precision=14 で16KB)、相対誤差は概ね 1.04 / sqrt(2^precision) となる。
+     * @n    要素数が少ない間はハッシュ値をそのまま保持して厳密に数え、その容量がレジスタの半分を超えた時点でレジスタに移行する。
+     * @n    @ref merge でスレッド間やバッチ間のスケッチを統合できる。
+     */
+    class DistinctSketch
+    {
+    public:
+        /**
+         * @brief コンストラクタ
+         * 
+         * @param int precision レジスタ数の2の指数 (4 ~ 18)
+         */
+        explicit DistinctSketch(const int& precision=14)
+        : precision_(precision)
+        {
+            if(precision < 4 || precision > 18)
+                throw std::out_of_range("precision must be in [4, 18].");
+        }
+
+        /**
+         * @fn update
+         * @brief 文字列を1つ追加する (空文字は欠損として無視する)
+         */
+        void update(const std::string& value)
+        {
+            if(!value.empty())
+                update_hash(hash_string(value));
+        }
+
+        /**
+         * @fn update_hash
+         * @brief 64bitハッシュ値を1つ追加する
+         */
+        void update_hash(const std::uint64_t& hash)
+        {
+            if(registers_.empty())
+            {
+                hashes_.push_back(hash);
+                if(hashes_.size() > sparse_limit())
+                    compact();
+                return;
+            }
+            const std::size_t index = static_cast<std::size_t>(hash >> (64 - precision_));
+            const std::uint8_t rank = leading_zeros((hash << precision_) | (std::uint64_t(1) << (precision_ - 1))) + 1;
+            registers_[index] = (std::max)(registers_[index], rank);
+        }
+
+        /**
+         * @fn merge
+         * @brief 他のスケッチの内容を統合する (精度が同じであること)
+         */
+        void merge(const DistinctSketch& other)
+        {
+            if(other.precision_ != precision_)
+                throw std::runtime_error("precision of sketches must be same.");
+            if(!other.registers_.empty())
+            {
+                densify();
+                for(std::size_t i = 0; i < registers_.size(); i++)
+                    registers_[i] = (std::max)(registers_[i], other.registers_[i]);
+            }
+            for(const auto& hash : other.hashes_)
+                update_hash(hash);
+        }
+
+        /**
+         * @fn estimate
+         * @brief 異なり数の推定値を返す
+         */
+        double estimate() const
+        {
+            if(registers_.empty())
+            {
+                auto hashes = hashes_;
+                std::sort(hashes.begin(), hashes.end());
+                return static_cast<double>(std::unique(hashes.begin(), hashes.end()) - hashes.begin());
+            }
+
+            const double m = static_cast<double>(registers_.size());
+            double sum = 0.0;
+            std::size_t zeros = 0;
+            for(const auto& r : registers_)
+            {
+                sum += std::ldexp(1.0, -static_cast<int>(r));
+                zeros += r == 0;
+            }
+            const double estimate = 0.7213 / (1.0 + 1.079 / m) * m * m / sum;
+            if(estimate <= 2.5 * m && zeros > 0)
+                return m * std::log(m / zeros); // linear counting for small cardinalities
+            return estimate;
+        }
+
+    private:
+        std::size_t sparse_limit() const
+        {
+            return (std::size_t(1) << precision_) / 16;
+        }
+
+        void compact()
+        {
+            std::sort(hashes_.begin(), hashes_.end());
+            hashes_.erase(std::unique(hashes_.begin(), hashes_.end()), hashes_.end());
+            if(hashes_.size() * 2 > sparse_limit())
+                densify();
+        }
+
+        void densify()
+        {
+            if(!registers_.empty())
+                return;
+            registers_.assign(std::size_t(1) << precision_, 0);
+            std::vector<std::uint64_t> hashes;
+            hashes.swap(hashes_);
+            for(const auto& hash : hashes)
+                update_hash(hash);
+        }
+
+        static std::uint8_t leading_zeros(std::uint64_t value)
+        {
+            std::uint8_t n = 0;
+            for(std::uint64_t bit = std::uint64_t(1) << 63; bit && !(value & bit); bit >>= 1)
+                n++;
+            return n;
+        }
+
+        int precision_;
+        std::vector<std::uint64_t> hashes_;     //!< 疎な間の重複を含むハッシュ値
+        std::vector<std::uint8_t> registers_;   //!< 密に移行後のレジスタ
+    };
+
+    /**
+     * @class HeavyHitters
+     * @brief 出現頻度の高い値を求めるためのマージ可能なスケッチ (Space-Saving)
+     * @note 最大 capacity 個のカウンタのみを保持し、未登録の値は最小のカウンタを置き換える。
+     * @n    カウンタは最小ヒープで管理するため、1要素あたりの更新は O(log capacity) となる。
+     * @n    推定頻度は真の頻度以上かつ 真の頻度 + 要素数 / capacity 以下となる。
+     */
+    class HeavyHitters
+    {
+    public:
+        /**
+         * @brief コンストラクタ
+         * 
+         * @param std::size_t capacity 保持するカウンタの数
+         */
+        explicit HeavyHitters(const std::size_t& capacity=1024)
+        : capacity_(std::max<std::size_t>(capacity, 1))
+        {}
+
+        /**
+         * @fn update
+         * @brief 値を1つ追加する
+         */
+        void update(const std::string& value, const std::uint64_t& count=1)
+        {
+            const auto it = position_.find(value);
+            if(it != position_.end())
+            {
+                heap_[it->second].count += count;
+                sift_down(it->second);
+                return;
+            }
+            if(heap_.size() < capacity_)
+            {
+                const Counter counter = {value, count, 0};
+                heap_.push_back(counter);
+                position_[value] = heap_.size() - 1;
+                sift_up(heap_.size() - 1);
+                return;
+            }
+            // replace the smallest counter
+            position_.erase(heap_[0].value);
+            heap_[0].error  = heap_[0].count;
+            heap_[0].count += count;
+            heap_[0].value  = value;
+            position_[value] = 0;
+            sift_down(0);
+        }
+
+        /**
+         * @fn merge
+         * @brief 他のスケッチの内容を統合する
+         * @note 一方にしか存在しない値は、他方の最小カウンタの値 (満杯でなければ0) を加算して上限を保つ。
+         */
+        void merge(const HeavyHitters& other)
+        {
+            const std::uint64_t own_min   = heap_.size() == capacity_ ? heap_[0].count : 0;
+            const std::uint64_t other_min = other.heap_.size() == other.capacity_ ? other.heap_[0].count : 0;
+            std::vector<Counter> counters;
+            for(const auto& counter : heap_)
+            {
+                const auto it = other.position_.find(counter.value);
+                const Counter merged = {counter.value, 
+                                        counter.count + (it != other.position_.end() ? other.heap_[it->second].count : other_min), 
+                                        counter.error + (it != other.position_.end() ? other.heap_[it->second].error : other_min)};
+                counters.push_back(merged);
+            }
+            for(const auto& counter : other.heap_)
+            {
+                if(position_.count(counter.value))
+                    continue;
+                const Counter merged = {counter.value, counter.count + own_min, counter.error + own_min};
+                counters.push_back(merged);
+            }
+
+            std::sort(counters.begin(), counters.end(), [](const Counter& a, const Counter& b) { return a.count > b.count || (a.count == b.count && a.value < b.value); });
+            if(counters.size() > capacity_)
+                counters.resize(capacity_);
+            heap_.clear();
+            position_.clear();
+            for(auto& counter : counters)
+            {
+                heap_.push_back(std::move(counter));
+                position_[heap_.back().value] = heap_.size() - 1;
+                sift_up(heap_.size() - 1);
+            }
+        }
+
+        /**
+         * @fn top
+         * @brief 推定頻度の高い順に最大 n 個の値と推定頻度の組を返す (n=0 の場合は全て)
+         */
+        std::vector<std::pair<std::string, std::uint64_t>> top(const std::size_t& n=0) const
+        {
+            std::vector<std::pair<std::string, std::uint64_t>> result;
+            for(const auto& counter : heap_)
+                result.push_back(std::make_pair(counter.value, counter.count));
+            std::sort(result.begin(), result.end(), [](const std::pair<std::string, std::uint64_t>& a, const std::pair<std::string, std::uint64_t>& b)
+            {
+                return a.second > b.second || (a.second == b.second && a.first < b.first);
+            });
+            if(n && result.size() > n)
+                result.resize(n);
+            return result;
+        }
+
+        /**
+         * @fn error
+         * @brief 値の推定頻度に含まれうる誤差の上限を返す (未登録の値は最小のカウンタの値)
+         */
+        std::uint64_t error(const std::string& value) const
+        {
+            const auto it = position_.find(value);
+            if(it != position_.end())
+                return heap_[it->second].error;
+            return heap_.size() == capacity_ ? heap_[0].count : 0;
+        }
+
+    private:
+        struct Counter
+        {
+            std::string value;
+            std::uint64_t count;
+            std::uint64_t error;
+        };
+
+        void swap(const std::size_t& a, const std::size_t& b)
+        {
+            std::swap(heap_[a], heap_[b]);
+            position_[heap_[a].value] = a;
+            position_[heap_[b].value] = b;
+        }
+
+        void sift_up(std::size_t i)
+        {
+            while(i > 0 && heap_[(i - 1) / 2].count > heap_[i].count)
+            {
+                swap(i, (i - 1) / 2);
+                i = (i - 1) / 2;
+            }
+        }
+
+        void sift_down(std::size_t i)
+        {
+            while(true)
+            {
+                std::size_t smallest = i;
+                const std::size_t left = 2 * i + 1, right = 2 * i + 2;
+                if(left < heap_.size() && heap_[left].count < heap_[smallest].count)
+                    smallest = left;
+                if(right < heap_.size() && heap_[right].count < heap_[smallest].count)
+                    smallest = right;
+                if(smallest == i)
+                    return;
+                swap(i, smallest);
+                i = smallest;
+            }
+        }
+
+        std::size_t capacity_;
+        std::vector<Counter> heap_;                                 //!< 頻度の最小ヒープ
+        std::unordered_map<std::string, std::size_t> position_;     //!< 値 -> ヒープ内の位置
+    };
+
+    /**
+     * @class GroupBy
+     * @brief @ref groupby で生成されるグループ集計用クラス
+     * @note 生成元のDataFrameを参照するため、生成元より長く生存させないこと。
+     */
+    class GroupBy
+    {
+    public:
+        /**
+         * @fn agg
+         * @brief グループごとの集計メソッド
+         * 
+         * @param std::vector<std::pair<std::string, Aggregation>> spec 集計対象の列名と集計方法の組のリスト
+         * @param enum Execution execution 並列実行モード { AUTO : データ量に応じて自動選択, SEQUENTIAL : 逐次, PARALLEL : 並列 }
+         * @return DataFrame キー列と集計結果の列を持つDataFrameインスタンス (グループは初出順に並ぶ)
+         * @note 集計結果の列名は対象の列名とする。同じ列を複数の方法で集計する場合は "列名_sum" のように集計方法名を付加する。
+         * @n    SUM, MEAN, MIN, MAX は数値に変換できない要素を、COUNT, FIRST, LAST は空文字の要素を除外して集計する。
+         * @n    数値の要素がないグループの SUM, MEAN, MIN, MAX は空文字とする。
+         * @n    並列実行時は行を分割して各スレッドで事前集計し、キーのハッシュ値で分割したパーティションごとに独立して統合する。
+         */
+        DataFrame agg(const std::vector<std::pair<std::string, enum Aggregation>>& spec, const enum Execution& execution=AUTO) const
+        {
+            if(thread_size(execution, frame_->data_.size()) > 1)
+                return frame_->partitioned_group_aggregate(keys_, spec, thread_size(execution, frame_->data_.size()));
+            return frame_->group_aggregate(keys_, spec);
+        }
+
+        /**
+         * @fn quantile
+         * @brief グループごとの分位点を求めるメソッド
+         * 
+         * @param std::vector<std::string> columns 対象の列名
+         * @param double q 分位点 (0 <= q <= 1)
+         * @param bool approximate true の場合はグループごとの @ref QuantileSketch による近似値を求める
+         * @return DataFrame キー列と各列の分位点を持つDataFrameインスタンス (グループは初出順に並ぶ)
+         * @note 数値に変換できない要素は除外する。厳密値は線形補間による。
+         */
+        DataFrame quantile(const std::vector<std::string>& columns, const double& q, const bool& approximate=false) const
+        {
+            return frame_->group_quantile(keys_, frame_->indices_of(columns), q, approximate);
+        }
+
+        /**
+         * @fn nunique
+         * @brief グループごとの異なり数を求めるメソッド
+         * 
+         * @param std::vector<std::string> columns 対象の列名
+         * @param bool approximate true の場合はグループごとの @ref DistinctSketch による近似値を求める
+         * @return DataFrame キー列と各列の異なり数を持つDataFrameインスタンス (グループは初出順に並ぶ)
+         * @note 空文字の要素は除外する。近似値のスケッチは小さいグループでは厳密に数える疎な表現のまま保持される。
+         */
+        DataFrame nunique(const std::vector<std::string>& columns, const bool& approximate=false) const
+        {
+            return frame_->group_nunique(keys_, frame_->indices_of(columns), approximate);
+        }
+
+    private:
+        friend class DataFrame;
+
+        GroupBy(const DataFrame& frame, const std::vector<std::size_t>& keys)
+        : frame_(&frame), keys_(keys)
+        {}
+
+        const DataFrame* frame_;
+        std::vector<std::size_t> keys_;
+    };
+
+    /**
+     * @class Rolling
+     * @brief @ref rolling で生成される移動窓集計用クラス
+     * @note 各行の計算量は窓の大きさによらず O(1) (合計・平均・標準偏差は差分更新、最小・最大は単調キュー)。
+     * @n    数値列のみを対象とし、数値に変換できない要素は欠損として窓内の要素数に含めない。
+     * @n    窓内の要素数が最小要素数に満たない行の結果は空文字とする。
+     * @n    生成元のDataFrameを参照するため、生成元より長く生存させないこと。
+     */
+    class Rolling
+    {
+    public:
+        DataFrame sum() const
+        {
+            return frame_->rolling_aggregate(*this, ROLLING_SUM, 0);
+        }
+
+        DataFrame mean() const
+        {
+            return frame_->rolling_aggregate(*this, ROLLING_MEAN, 0);
+        }
+
+        DataFrame (min)() const
+        {
+            return frame_->rolling_aggregate(*this, ROLLING_MIN, 0);
+        }
+
+        DataFrame (max)() const
+        {
+            return frame_->rolling_aggregate(*this, ROLLING_MAX, 0);
+        }
+
+        DataFrame var(const int& ddof=1) const
+        {
+            return frame_->rolling_aggregate(*this, ROLLING_VAR, ddof);
+        }
+
+        DataFrame std(const int& ddof=1) const
+        {
+            return frame_->rolling_aggregate(*this, ROLLING_STD, ddof);
+        }
+
+    private:
+        friend class DataFrame;
+
+        enum Statistic { ROLLING_SUM, ROLLING_MEAN, ROLLING_MIN, ROLLING_MAX, ROLLING_VAR, ROLLING_STD };
+
+        Rolling(const DataFrame& frame, const int& window, const double& duration, const std::string& on, const int& min_periods)
+        : frame_(&frame), window_(window), duration_(duration), on_(on), min_periods_(min_periods)
+        {}
+
+        const DataFrame* frame_;
+        int window_;
+        double duration_;
+        std::string on_;
+        int min_periods_;
+    };
+
+    /**
+     * @class Ewm
+     * @brief 指数加重移動平均・分散の計算用クラス
+     * @note 列名ごとに計算途中の状態を保持するため、バッチ単位で順に与えることで全履歴を読み直さずに計算を継続できる。
+     * @n    数値列のみを対象とし、数値に変換できない要素は無視する。(結果は直前の値を引き継ぐ)
+     * @n    計算式は pandas の ewm(ignore_na=True) に準ずる。
+     */
+    class Ewm
+    {
+    public:
+        /**
+         * @brief コンストラクタ
+         * 
+         * @param double value 減衰パラメータの値
+         * @param enum Decay decay 減衰パラメータの種類 { ALPHA : 平滑化係数 (0 < α <= 1), SPAN : 期間 (α = 2 / (span + 1)), COM : 重心 (α = 1 / (1 + com)), HALFLIFE : 半減期 (α = 1 - exp(-ln2 / halflife)) }
+         * @param bool adjust true の場合は初期の重みを補正する
+         */
+        explicit Ewm(const double& value, const enum Decay& decay=ALPHA, const bool& adjust=true)
+        : frame_(nullptr), alpha_(to_alpha(value, decay)), adjust_(adjust)
+        {}
+
+        /**
+         * @fn mean
+         * @brief 生成元のDataFrameの指数加重移動平均を返す (保持している状態は変更しない)
+         */
+        DataFrame mean() const
+        {
+            std::map<std::string, State> states;
+            return bound_frame().ewm_aggregate(*this, states, false);
+        }
+
+        /**
+         * @fn var
+         * @brief 生成元のDataFrameの指数加重移動分散 (不偏) を返す (保持している状態は変更しない)
+         */
+        DataFrame var() const
+        {
+            std::map<std::string, State> states;
+            return bound_frame().ewm_aggregate(*this, states, true);
+        }
+
+        /**
+         * @fn mean
+         * @brief バッチの指数加重移動平均を、前回までのバッチの状態を引き継いで返す
+         * 
+         * @param DataFrame batch 続きのデータ
+         */
+        DataFrame mean(const DataFrame& batch)
+        {
+            return batch.ewm_aggregate(*this, mean_states_, false);
+        }
+
+        /**
+         * @fn var
+         * @brief バッチの指数加重移動分散 (不偏) を、前回までのバッチの状態を引き継いで返す
+         * 
+         * @param DataFrame batch 続きのデータ
+         */
+        DataFrame var(const DataFrame& batch)
+        {
+            return batch.ewm_aggregate(*this, var_states_, true);
+        }
+
+        /**
+         * @fn reset
+         * @brief 保持している状態を破棄する
+         */
+        void reset()
+        {
+            mean_states_.clear();
+            var_states_.clear();
+        }
+
+    private:
+        friend class DataFrame;
+
+        struct State
+        {
+            std::size_t count;
+            double mean;
+            double cov;
+            double sum_weight;
+            double sum_weight2;
+            double old_weight;
+        };
+
+        static double to_alpha(const double& value, const enum Decay& decay)
+        {
+            double alpha = value;
+            if(decay == SPAN)
+                alpha = value >= 1.0 ? 2.0 / (value + 1.0) : 0.0;
+            else if(decay == COM)
+                alpha = value >= 0.0 ? 1.0 / (1.0 + value) : 0.0;
+            else if(decay == HALFLIFE)
+                alpha = value > 0.0 ? 1.0 - std::exp(-std::log(2.0) / value) : 0.0;
+            if(!(alpha > 0.0 && alpha <= 1.0))
+                throw std::out_of_range("invalid decay parameter.");
+            return alpha;
+        }
+
+        const DataFrame& bound_frame() const
+        {
+            if(frame_ == nullptr)
+                throw std::runtime_error("Ewm is not bound to DataFrame.");
+            return *frame_;
+        }
+
+        const DataFrame* frame_;
+        double alpha_;
+        bool adjust_;
+        std::map<std::string, State> mean_states_;
+        std::map<std::string, State> var_states_;
+    };
+
+    /**
+     * @class Window
+     * @brief @ref window で生成されるパーティション単位の窓関数用クラス
+     * @note 生成時にパーティション列・順序列による並べ替えを1回だけ行い、全ての窓関数でその順序を共有する。
+     * @n    各窓関数の結果は元の行順の1列のDataFrameとして返すため、@ref assign でそのまま列として追加できる。
+     * @n    生成元のDataFrameを参照するため、生成元より長く生存させないこと。
+     */
+    class Window
+    {
+    public:
+        /**
+         * @fn row_number
+         * @brief パーティション内の通し番号 (1始まり) を返す
+         */
+        DataFrame row_number() const
+        {
+            std::vector<std::string> result(order_.size());
+            for(std::size_t p = 0; p < order_.size(); p++)
+                result[order_[p]] = std::to_string(p - start_[p] + 1);
+            return column("row_number", result);
+        }
+
+        /**
+         * @fn rank
+         * @brief パーティション内の順位を返す (同順位は同じ値とし、次の順位は同順位の数だけ飛ばす)
+         */
+        DataFrame rank() const
+        {
+            std::vector<std::string> result(order_.size());
+            std::size_t rank = 0;
+            for(std::size_t p = 0; p < order_.size(); p++)
+            {
+                if(peer_[p])
+                    rank = p - start_[p] + 1;
+                result[order_[p]] = std::to_string(rank);
+            }
+            return column("rank", result);
+        }
+
+        /**
+         * @fn dense_rank
+         * @brief パーティション内の順位を返す (同順位は同じ値とし、次の順位は飛ばさない)
+         */
+        DataFrame dense_rank() const
+        {
+            std::vector<std::string> result(order_.size());
+            std::size_t rank = 0;
+            for(std::size_t p = 0; p < order_.size(); p++)
+            {
+                if(start_[p] == p)
+                    rank = 0;
+                if(peer_[p])
+                    rank++;
+                result[order_[p]] = std::to_string(rank);
+            }
+            return column("dense_rank", result);
+        }
+
+        /**
+         * @fn shift
+         * @brief パーティション内で periods 行前の値を返す (該当する行がなければ空文字)
+         * 
+         * @param std::string name 対象の列名
+         * @param int periods ずらす行数 (負数の場合は後の行の値)
+         */
+        DataFrame shift(const std::string& name, const int& periods=1) const
+        {
+            const std::size_t c = frame_->index_of(name);
+            std::vector<std::string> result(order_.size());
+            for(std::size_t p = 0; p < order_.size(); p++)
+            {
+                const long long other = static_cast<long long>(p) - periods;
+                if(other < 0 || other >= static_cast<long long>(order_.size()) || start_[static_cast<std::size_t>(other)] != start_[p])
+                    continue;
+                result[order_[p]] = frame_->data_[order_[static_cast<std::size_t>(other)]][c];
+            }
+            return column(name, result);
+        }
+
+        /**
+         * @fn lag
+         * @brief パーティション内で offset 行前の値を返す
+         */
+        DataFrame lag(const std::string& name, const int& offset=1) const
+        {
+            return shift(name, offset);
+        }
+
+        /**
+         * @fn lead
+         * @brief パーティション内で offset 行後の値を返す
+         */
+        DataFrame lead(const std::string& name, const int& offset=1) const
+        {
+            return shift(name, -offset);
+        }
+
+    private:
+        friend class DataFrame;
+
+        Window(const DataFrame& frame, std::vector<std::size_t>&& order, std::vector<std::size_t>&& start, std::vector<bool>&& peer)
+        : frame_(&frame), order_(std::move(order)), start_(std::move(start)), peer_(std::move(peer))
+        {}
+
+        static DataFrame column(const std::string& name, const std::vector<std::string>& values)
+        {
+            std::vector<std::vector<std::string>> data;
+            data.reserve(values.size());
+            for(const auto& value : values)
+                data.push_back(std::vector<std::string>(1, value));
+            return DataFrame(std::vector<std::string>(1, name), std::move(data));
+        }
+
+        const DataFrame* frame_;
+        std::vector<std::size_t> order_;    //!< 並べ替え後の位置 -> 元の行番号
+        std::vector<std::size_t> start_;    //!< 並べ替え後の位置 -> 属するパーティションの先頭位置
+        std::vector<bool> peer_;            //!< 並べ替え後の位置が同順位の先頭であるか
+    };
+
+    /**
+     * @class LazyFrame
+     * @brief 操作を論理プランとして記録し、@ref collect で一括実行する遅延評価用クラス
+     * @note @ref scan_csv または @ref lazy で生成する。collect 時に以下の最適化を行う。
+     * @n    - 絞り込み条件を列の選択・並べ替え・グループ化(キー列の条件のみ)より前に移動し、CSV読取時に評価する
+     * @n    - 隣接する絞り込み条件を1回の走査に統合する
+     * @n    - 後段で使用しない列を読み取らない・取り出さない
+     * @n    @ref lazy で生成した場合は生成元のDataFrameを参照するため、生成元より長く生存させないこと。
+     */
+    class LazyFrame
+    {
+    public:
+        /**
+         * @class GroupBy
+         * @brief @ref LazyFrame::groupby で生成されるグループ集計用クラス
+         */
+        class GroupBy
+        {
+        public:
+            /**
+             * @fn agg
+             * @brief グループごとの集計を論理プランに追加する (集計方法は @ref DataFrame::GroupBy::agg と同じ)
+             */
+            LazyFrame agg(const std::vector<std::pair<std::string, enum Aggregation>>& spec) const
+            {
+                Step step(Step::GROUPBY);
+                step.columns = keys_;
+                step.spec    = spec;
+                return frame_->append(step);
+            }
+
+        private:
+            friend class LazyFrame;
+
+            GroupBy(const LazyFrame& frame, const std::vector<std::string>& keys)
+            : frame_(std::make_shared<LazyFrame>(frame)), keys_(keys)
+            {}
+
+            std::shared_ptr<LazyFrame> frame_;
+            std::vector<std::string> keys_;
+        };
+
+        /**
+         * @fn select
+         * @brief 列の選択を論理プランに追加する
+         */
+        LazyFrame select(const std::vector<std::string>& columns) const
+        {
+            Step step(Step::SELECT);
+            step.columns = columns;
+            return append(step);
+        }
+
+        /**
+         * @fn filter
+         * @brief 数値との比較による絞り込みを論理プランに追加する (比較方法は @ref DataFrame::compare と同じ)
+         */
+        LazyFrame filter(const std::string& column, const enum Compare& op, const double& value) const
+        {
+            Step step(Step::FILTER);
+            step.predicates.push_back(Predicate{column, op, true, value, std::string()});
+            return append(step);
+        }
+
+        /**
+         * @fn filter
+         * @brief 文字列との比較による絞り込みを論理プランに追加する (比較方法は @ref DataFrame::compare と同じ)
+         */
+        LazyFrame filter(const std::string& column, const enum Compare& op, const std::string& value) const
+        {
+            Step step(Step::FILTER);
+            step.predicates.push_back(Predicate{column, op, false, 0.0, value});
+            return append(step);
+        }
+
+        /**
+         * @fn sort_values
+         * @brief 並べ替えを論理プランに追加する (並べ替え方法は @ref DataFrame::sort_values と同じ)
+         */
+        LazyFrame sort_values(const std::vector<std::string>& columns, const bool& ascending=true) const
+        {
+            return sort_values(columns, std::vector<bool>(columns.size(), ascending));
+        }
+
+        /**
+         * @fn sort_values
+         * @brief 並べ替えを論理プランに追加する (並べ替え方法は @ref DataFrame::sort_values と同じ)
+         */
+        LazyFrame sort_values(const std::vector<std::string>& columns, const std::vector<bool>& ascending) const
+        {
+            Step step(Step::SORT);
+            step.columns   = columns;
+            step.ascending = ascending;
+            return append(step);
+        }
+
+        /**
+         * @fn groupby
+         * @brief グループ化 (続けて agg で集計方法を指定する)
+         */
+        GroupBy groupby(const std::vector<std::string>& keys) const
+        {
+            return GroupBy(*this, keys);
+        }
+
+        /**
+         * @fn merge
+         * @brief 他の論理プランとの結合を論理プランに追加する (結合方法は @ref DataFrame::merge と同じ)
+         */
+        LazyFrame merge(const LazyFrame& other, const std::vector<std::string>& on, const enum Join& how=INNER) const
+        {
+            Step step(Step::JOIN);
+            step.columns = on;
+            step.other   = std::make_shared<LazyFrame>(other);
+            step.how     = how;
+            return append(step);
+        }
+
+        /**
+         * @fn collect
+         * @brief 論理プランを最適化して実行する
+         * 
+         * @return DataFrame 実行結果のDataFrameインスタンス
+         */
+        DataFrame collect() const
+        {
+            const LazyFrame plan = optimize();
+            DataFrame result = plan.frame_ 
+                             ? plan.frame_->scan(plan.projection_, plan.predicates_) 
+                             : parse_csv(plan.file_path_, plan.header_, plan.separator_, plan.new_line_, plan.auto_trim_, plan.projection_, plan.predicates_);
+            for(const auto& step : plan.steps_)
+            {
+                switch(step.kind)
+                {
+                case Step::SELECT:
+                    result = result[step.columns];
+                    break;
+                case Step::FILTER:
+                    result = result.scan(nullptr, step.predicates);
+                    break;
+                case Step::SORT:
+                    result = result.sort_values(step.columns, step.ascending);
+                    break;
+                case Step::GROUPBY:
+                    result = result.groupby(step.columns).agg(step.spec);
+                    break;
+                default: // JOIN
+                    result = result.merge(step.other->collect(), step.columns, step.how);
+                    break;
+                }
+            }
+            return result;
+        }
+
+        /**
+         * @fn explain
+         * @brief 最適化後の論理プランを文字列で返す
+         */
+        std::string explain() const
+        {
+            const LazyFrame plan = optimize();
+            std::stringstream ss;
+            ss << "SCAN " << (plan.frame_ ? std::string("DataFrame") : plan.file_path_);
+            if(plan.projection_)
+                ss << " columns={" << concat(*plan.projection_, ",") << "}";
+            if(!plan.predicates_.empty())
+                ss << " filter={" << describe_predicates(plan.predicates_) << "}";
+            ss << std::endl;
+            const char* names[] = {"SELECT", "FILTER", "SORT", "GROUPBY", "JOIN"};
+            for(const auto& step : plan.steps_)
+            {
+                ss << names[step.kind] << " ";
+                if(step.kind == Step::FILTER)
+                    ss << "{" << describe_predicates(step.predicates) << "}";
+                else
+                    ss << "{" << concat(step.columns, ",") << "}";
+                ss << std::endl;
+            }
+            return ss.str();
+        }
+
+    private:
+        friend class DataFrame;
+
+        struct Predicate
+        {
+            std::string column;
+            enum Compare op;
+            bool numeric;
+            double number;
+            std::string text;
+        };
+
+        struct Step
+        {
+            enum Kind { SELECT, FILTER, SORT, GROUPBY, JOIN };
+
+            explicit Step(const Kind& kind)
+            : kind(kind), how(INNER)
+            {}
+
+            Kind kind;
+            std::vector<std::string> columns;
+            std::vector<Predicate> predicates;
+            std::vector<bool> ascending;
+            std::vector<std::pair<std::string, enum Aggregation>> spec;
+            std::shared_ptr<LazyFrame> other;
+            enum Join how;
+        };
+
+        LazyFrame(const std::string& file_path, const bool& header, const std::string& separator, const std::string& new_line, const bool& auto_trim)
+        : frame_(nullptr), file_path_(file_path), header_(header), separator_(separator), new_line_(new_line), auto_trim_(auto_trim)
+        {}
+
+        explicit LazyFrame(const DataFrame& frame)
+        : frame_(&frame), file_path_(), header_(true), separator_(), new_line_(), auto_trim_(true)
+        {}
+
+        LazyFrame append(const Step& step) const
+        {
+            LazyFrame result(*this);
+            result.steps_.push_back(step);
+            return result;
+        }
+
+        static bool contains(const std::vector<std::string>& columns, const std::string& column)
+        {
+            return std::find(columns.begin(), columns.end(), column) != columns.end();
+        }
+
+        static std::string describe_predicates(const std::vector<Predicate>& predicates)
+        {
+            const char* ops[] = {"==", "!=", "<", "<=", ">", ">="};
+            std::vector<std::string> result;
+            for(const auto& p : predicates)
+                result.push_back(p.column + " " + ops[p.op] + " " + (p.numeric ? format_number(p.number) : "'" + p.text + "'"));
+            return concat(result, " & ");
+        }
+
+        /**
+         * @fn optimize
+         * @brief 絞り込み条件の前方移動・統合と、使用する列の絞り込みを行った論理プランを返す
+         */
+        LazyFrame optimize() const
+        {
+            LazyFrame plan(*this);
+            auto& steps = plan.steps_;
+
+            // predicate pushdown : move filters before select/sort/groupby(key only)
+            for(std::size_t i = 1; i < steps.size(); i++)
+            {
+                for(auto j = i; j > 0 && steps[j].kind == Step::FILTER; j--)
+                {
+                    const auto& previous = steps[j - 1];
+                    bool movable = previous.kind == Step::SORT;
+                    if(previous.kind == Step::SELECT || previous.kind == Step::GROUPBY)
+                        movable = std::all_of(steps[j].predicates.begin(), steps[j].predicates.end(), [&previous](const Predicate& p) { return contains(previous.columns, p.column); });
+                    if(!movable)
+                        break;
+                    std::swap(steps[j - 1], steps[j]);
+                }
+            }
+
+            // filter fusion : merge adjacent filters into one
+            std::vector<Step> fused;
+            for(const auto& step : steps)
+            {
+                if(step.kind == Step::FILTER && !fused.empty() && fused.back().kind == Step::FILTER)
+                    fused.back().predicates.insert(fused.back().predicates.end(), step.predicates.begin(), step.predicates.end());
+                else
+                    fused.push_back(step);
+            }
+            steps.swap(fused);
+
+            // leading filter is evaluated while scanning
+            if(!steps.empty() && steps.front().kind == Step::FILTER)
+            {
+                plan.predicates_ = steps.front().predicates;
+                steps.erase(steps.begin());
+            }
+
+            // projection pushdown : collect the columns required by later steps
+            bool all = true;
+            std::vector<std::string> required;
+            for(auto step = steps.rbegin(); step != steps.rend(); step++)
+            {
+                switch(step->kind)
+                {
+                case Step::SELECT:
+                    if(!all)
+                    {
+                        std::vector<std::string> columns;
+                        for(const auto& column : step->columns)
+                            if(contains(required, column))
+                                columns.push_back(column);
+                        step->columns = columns;
+                    }
+                    required = step->columns;
+                    all = false;
+                    break;
+                case Step::FILTER:
+                    for(const auto& p : step->predicates)
+                        if(!all && !contains(required, p.column))
+                            required.push_back(p.column);
+                    break;
+                case Step::SORT:
+                    for(const auto& column : step->columns)
+                        if(!all && !contains(required, column))
+                            required.push_back(column);
+                    break;
+                case Step::GROUPBY:
+                    required = step->columns;
+                    for(const auto& s : step->spec)
+                        if(!contains(required, s.first))
+                            required.push_back(s.first);
+                    all = false;
+                    break;
+                default: // JOIN
+                    all = true;
+                    required.clear();
+                    break;
+                }
+            }
+            if(!all)
+                plan.projection_ = std::make_shared<std::vector<std::string>>(required);
+            return plan;
+        }
+
+        const DataFrame* frame_;
+        std::string file_path_;
+        bool header_;
+        std::string separator_;
+        std::string new_line_;
+        bool auto_trim_;
+        std::vector<Step> steps_;
+        std::shared_ptr<std::vector<std::string>> projection_;
+        std::vector<Predicate> predicates_;
+    };
+
+    /**
+     * @fn DataFrame
+     * @brief コピーコンストラクタ
+     * 
+     * @param DataFrame other コピー元
+     */
+    DataFrame(const DataFrame& other)
+     : header_(other.header_), data_(other.data_)
+    {}
+
+    /**
+     * @fn DataFrame
+     * @brief ムーブコンストラクタ
+     * 
+     * @param DataFrame other ムーブ元
+     */
+    DataFrame(DataFrame&& other)
+     : header_(std::move(other.header_)), data_(std::move(other.data_))
+    {}
+
+    /**
+     * @fn operator=
+     * @brief コピーメソッド
+     * 
+     * @param DataFrame  
+     * @return DataFrame& 自身の参照
+     */
+    DataFrame& operator=(const DataFrame& other)
+    {
+        header_ = other.header_;
+        data_   = other.data_;
+        return *this;
+    }
+
+    /**
+     * @fn operator=
+     * @brief ムーブメソッド
+     * 
+     * @param DataFrame  
+     * @return DataFrame& 自身の参照
+     */
+    DataFrame& operator=(DataFrame&& other)
+    {
+        header_ = std::move(other.header_);
+        data_   = std::move(other.data_);
+        return *this;
+    }
+
+    /**
+     * @fn read_csv
+     * @brief CSV読取メソッド (Factory Method)
+     * 
+     * @param std::string file_path csvのファイルパス
+     * @param 
+     * @return DataFrame 読取後DataFrameインスタンス
+     */
+    static DataFrame read_csv(const std::string& file_path, const std::unordered_map<ReadCsvArgument, DynamicType>& arg_map)
+    {
+        const auto header       = arg_map.count(HEADER)    ? arg_map.at(HEADER).as<bool>()           : true;
+        const auto separator    = arg_map.count(SEPARATOR) ? arg_map.at(SEPARATOR).as<std::string>()  : ",";
+        const auto new_line     = arg_map.count(NEW_LINE)  ? arg_map.at(NEW_LINE).as<std::string>()  : "\n";
+        const auto auto_trim    = arg_map.count(AUTO_TRIM) ? arg_map.at(AUTO_TRIM).as<bool>()        : true;
+        return read_csv(file_path, header, separator, new_line, auto_trim);
+    }
+
+    /**
+     * @fn read_csv
+     * @brief CSV読取メソッド (Factory Method)
+     * 
+     * @param std::string file_path csvのファイルパス
+     * @param 
+     * @return DataFrame 読取後DataFrameインスタンス
+     */
+#ifdef __unix__
+    static DataFrame read_csv(const std::string& file_path, const bool& header=true, const std::string& separator = ",", const std::string& new_line =   "\n", const bool& auto_trim = true)
+#else
+    static DataFrame read_csv(const std::string& file_path, const bool& header=true, const std::string& separator = ",", const std::string& new_line = "\r\n", const bool& auto_trim = true)
+#endif
+    {
+        return parse_csv(file_path, header, separator, new_line, auto_trim, nullptr, {});
+    }
+
+    /**
+     * @fn scan_csv
+     * @brief CSVを読取対象とする遅延評価用インスタンスの生成メソッド (Factory Method)
+     * 
+     * @param std::string file_path csvのファイルパス (引数の意味は @ref read_csv と同じ)
+     * @return LazyFrame 遅延評価用インスタンス (collect 時に読み取る)
+     */
+#ifdef __unix__
+    static LazyFrame scan_csv(const std::string& file_path, const bool& header=true, const std::string& separator = ",", const std::string& new_line =   "\n", const bool& auto_trim = true)
+#else
+    static LazyFrame scan_csv(const std::string& file_path, const bool& header=true, const std::string& separator = ",", const std::string& new_line = "\r\n", const bool& auto_trim = true)
+#endif
+    {
+        return LazyFrame(file_path, header, separator, new_line, auto_trim);
+    }
+
+    /**
+     * @fn lazy
+     * @brief 自身を入力とする遅延評価用インスタンスの生成メソッド
+     * 
+     * @return LazyFrame 遅延評価用インスタンス (自身を参照するため、自身より長く生存させないこと)
+     */
+    LazyFrame lazy() const
+    {
+        return LazyFrame(*this);
+    }
+
+    /**
+     * @fn to_csv
+     * @brief csvファイルへの書込メソッド
+     * 
+     * @param std::stirng file_path 書込先ファイルパス 
+     * @param append 追記モードか、上書きモードか
+     * @param header ヘッダーを出力データに含めるか
+     * @param separator 区切り文字
+     */
+    void to_csv(const std::string& file_path, const bool& append=false, const bool& header=true, const std::string& separator=",") const
+    {
+        std::ofstream ofs;
+        append ? ofs.open(file_path, std::ios::app) : ofs.open(file_path); // switching append or overwrite.
+        if(!ofs) 
+            throw std::runtime_error("file path '" + file_path + "' doesn't exist.");
+
+        if(header)
+            ofs << concat(header_, separator) << std::endl;
+        
+        std::stringstream ss;
+        for (const auto& row : data_)
+            ss << concat(row, separator) << std::endl;
+        
+        auto result = ss.str();
+        
+        result.pop_back(); // pop back latest new line
+        ofs << result;
+    }
+
+
+    /**
+     * @fn operator[]
+     * @brief 列名によるDataFrameの切出メソッド
+     * 
+     * @param std::stirng target_column 取得対象の列名
+     * @return DataFrame 切出処理後の新たなDataFrameインスタンス
+     */
+    DataFrame operator[](const std::string& target_column) const
+    {
+        auto itr = std::find(header_.begin(), header_.end(), target_column);
+        
+        if (itr==header_.end())
+        {
+            std::stringstream ss;
+            ss << "target column '" << target_column << "' was not found.";
+            throw std::runtime_error(ss.str());
+        }
+
+        int index = std::distance(header_.begin(), itr);
+        std::vector<std::string> header = {header_.at(index)};
+        std::vector<std::vector<std::string>> data;
+
+        for(const auto& row : data_)
+            data.push_back({row.at(index)});
+
+        return DataFrame(std::move(header), std::move(data));
+    }
+
+    /**
+     * @fn operator[]
+     * @brief 列名によるDataFrameの切出メソッド
+     * 
+     * @param std::stirng target_column 取得対象の列名
+     * @return DataFrame 切出処理後の新たなDataFrameインスタンス
+     */
+    DataFrame operator[](const char* target_column) const
+    {
+        return this->operator[](std::string(target_column));
+    }
+
+    /**
+     * @fn operator[]
+     * @brief 列名によるDataFrameの切出メソッド
+     * 
+     * @param std::vector<std::stirng> target_column_list 取得対象の列名のリスト
+     * @return DataFrame 切出処理後の新たなDataFrameインスタンス
+     */
+    DataFrame operator[](const std::vector<std::string>& target_column_list) const
+    {
+        std::vector<int> indices;
+        for (const auto& column : target_column_list)
+        {
+            auto itr = std::find(header_.begin(), header_.end(), column);
+            if (itr==header_.end())
+                throw std::runtime_error("target column was not found.");
+            int index = std::distance(header_.begin(), itr);
+            indices.push_back(index);
+        }
+
+        std::vector<std::string> header;
+        for(const auto& index : indices)
+            header.push_back(header_[index]);
+
+        std::vector<std::string> row_data;
+        std::vector<std::vector<std::string>> data;
+        for(const auto& row : data_)
+        {
+            row_data.clear();
+            for(const auto& index : indices)
+                row_data.push_back(row[index]);
+            data.push_back(row_data);
+        }
+
+        return DataFrame(std::move(header), std::move(data));
+    }
+
+    /**
+     * @fn operator[]
+     * @brief 行インデックスによるDataFrameの切出メソッド
+     * 
+     * @param std::stirng target_row 取得対象の行インデックス
+     * @return DataFrame 切出処理後の新たなDataFrameインスタンス
+     * @note 負数を指定した場合の取得対象行のインデックスはpandasの仕様に従う。
+     * @n    --例--  df[-1] == df[0] ... true
+     */
+    DataFrame operator[](const int& target_row) const
+    {
+        int index;
+        index = target_row >= 0 ? target_row : data_.size() + target_row;
+        if (index < 0 || index >= data_.size())
+            throw std::out_of_range("index number [" + std::to_string(target_row) + "] was out of range");
+
+        return DataFrame(header_, {data_[index]});
+    }
+
+    /**
+     * @fn operator[]
+     * @brief 行の選択結果によるDataFrameの切出メソッド
+     * 
+     * @param Mask mask 行の選択結果
+     * @return DataFrame 切出処理後の新たなDataFrameインスタンス
+     */
+    DataFrame operator[](const Mask& mask) const
+    {
+        return filter(mask);
+    }
+
+    /**
+     * @fn filter
+     * @brief 行の選択結果によるDataFrameの切出メソッド
+     * 
+     * @param Mask mask 行の選択結果 (行数が一致していること)
+     * @return DataFrame 選択された行のみを持つ新たなDataFrameインスタンス
+     * @note --例-- df.filter(df["latency"] > 500.0 & df["host"] == "a");
+     */
+    DataFrame filter(const Mask& mask) const
+    {
+        if(mask.size() != data_.size())
+            throw std::runtime_error("mask size is different from row size.");
+
+        std::vector<std::vector<std::string>> data;
+        data.reserve(mask.count());
+        for(const auto& r : mask.indices())
+            data.push_back(data_[r]);
+        return DataFrame(header_, std::move(data));
+    }
+
+    /**
+     * @fn compare
+     * @brief 1列のDataFrameの各要素と数値との比較メソッド
+     * 
+     * @param enum Compare op 比較方法 { EQUAL, NOT_EQUAL, LESS, LESS_EQUAL, GREATER, GREATER_EQUAL }
+     * @param double value 比較する数値
+     * @return Mask 比較結果が真となる行の選択結果
+     * @note 数値に変換できない要素は NOT_EQUAL のみ真、それ以外は偽とする。(pandasのNaNとの比較と同じ)
+     */
+    Mask compare(const enum Compare& op, const double& value) const
+    {
+        if(header_.size() != 1)
+            throw std::runtime_error("compare method can be used to 1 column DataFrame only.");
+
+        std::vector<std::size_t> indices;
+        for(std::size_t r = 0; r < data_.size(); r++)
+            if(match(data_[r][0], op, value))
+                indices.push_back(r);
+        return Mask(data_.size(), std::move(indices));
+    }
+
+    /**
+     * @fn compare
+     * @brief 1列のDataFrameの各要素と文字列との比較メソッド
+     * 
+     * @param enum Compare op 比較方法 { EQUAL, NOT_EQUAL, LESS, LESS_EQUAL, GREATER, GREATER_EQUAL }
+     * @param std::string value 比較する文字列 (大小は辞書順で比較する)
+     * @return Mask 比較結果が真となる行の選択結果
+     */
+    Mask compare(const enum Compare& op, const std::string& value) const
+    {
+        if(header_.size() != 1)
+            throw std::runtime_error("compare method can be used to 1 column DataFrame only.");
+
+        std::vector<std::size_t> indices;
+        for(std::size_t r = 0; r < data_.size(); r++)
+            if(match(data_[r][0], op, value))
+                indices.push_back(r);
+        return Mask(data_.size(), std::move(indices));
+    }
+
+    Mask operator==(const double& value) const      { return compare(EQUAL, value); }
+    Mask operator!=(const double& value) const      { return compare(NOT_EQUAL, value); }
+    Mask operator< (const double& value) const      { return compare(LESS, value); }
+    Mask operator<=(const double& value) const      { return compare(LESS_EQUAL, value); }
+    Mask operator> (const double& value) const      { return compare(GREATER, value); }
+    Mask operator>=(const double& value) const      { return compare(GREATER_EQUAL, value); }
+    Mask operator==(const int& value) const         { return compare(EQUAL, static_cast<double>(value)); }
+    Mask operator!=(const int& value) const         { return compare(NOT_EQUAL, static_cast<double>(value)); }
+    Mask operator< (const int& value) const         { return compare(LESS, static_cast<double>(value)); }
+    Mask operator<=(const int& value) const         { return compare(LESS_EQUAL, static_cast<double>(value)); }
+    Mask operator> (const int& value) const         { return compare(GREATER, static_cast<double>(value)); }
+    Mask operator>=(const int& value) const         { return compare(GREATER_EQUAL, static_cast<double>(value)); }
+    Mask operator==(const std::string& value) const { return compare(EQUAL, value); }
+    Mask operator!=(const std::string& value) const { return compare(NOT_EQUAL, value); }
+    Mask operator==(const char* value) const        { return compare(EQUAL, std::string(value)); }
+    Mask operator!=(const char* value) const        { return compare(NOT_EQUAL, std::string(value)); }
+
+    /**
+     * @fn slice
      * @brief 行インデックスの開始・終了指定によるDataFrameの切出メソッド
      * 
-     * @param int start_index 開始インデックス
-     * @param int end_index   終了インデックス 
-     * @return DataFrame 切出処理後の新たなDataFrameインスタンス
+     * @param int start_index 開始インデックス
+     * @param int end_index   終了インデックス 
+     * @return DataFrame 切出処理後の新たなDataFrameインスタンス
+     */
+    DataFrame slice(const int& start_index, const int& end_index) const
+    {
+        const int s_index = (start_index  >= 0) ? start_index  : data_.size() + start_index;
+        const int e_index = (end_index    >= 0) ? end_index    : data_.size() + end_index;
+        if (s_index < 0 || s_index >= data_.size())
+            throw std::out_of_range("start index number was out of range");
+        if (e_index   < 0 || e_index   >= data_.size())
+            throw std::out_of_range("end index number was out of range");
+        if (s_index > e_index)
+            throw std::out_of_range("end index must be larger than start index.");
+        
+        std::vector<std::vector<std::string>> data;
+        for(auto i = s_index; i < e_index; i++)
+            data.push_back(data_[i]);
+
+        return DataFrame(header_, std::move(data));
+    }
+
+    /**
+     * @fn assign
+     * @brief 列の追加メソッド (同名の列がある場合は置き換える)
+     * 
+     * @param std::string name 追加する列名
+     * @param Expression expression 列の演算式 (例: df["a"] * 2.0 + df["b"])
+     * @return DataFrame 列追加後の新たなDataFrameインスタンス
+     * @note 演算結果がNaNの要素は空文字とする。
+     */
+    template<typename E>
+    DataFrame assign(const std::string& name, const Expression<E>& expression) const
+    {
+        const auto values = expression.evaluate();
+        if(values.size() != data_.size())
+            throw std::runtime_error("row size of assigned column is different.");
+
+        std::vector<std::string> column(values.size());
+        for(std::size_t r = 0; r < values.size(); r++)
+            column[r] = values[r] == values[r] ? format_number(values[r]) : std::string();
+        return assign_column(name, std::move(column));
+    }
+
+    /**
+     * @fn assign
+     * @brief 列の追加メソッド (同名の列がある場合は置き換える)
+     * 
+     * @param std::string name 追加する列名
+     * @param DataFrame column 追加する1列のDataFrameインスタンス (行数が一致していること)
+     * @return DataFrame 列追加後の新たなDataFrameインスタンス
+     */
+    DataFrame assign(const std::string& name, const DataFrame& column) const
+    {
+        if(column.header_.size() != 1)
+            throw std::runtime_error("assigned DataFrame must have 1 column.");
+        if(column.data_.size() != data_.size())
+            throw std::runtime_error("row size of assigned column is different.");
+
+        std::vector<std::string> values(column.data_.size());
+        for(std::size_t r = 0; r < values.size(); r++)
+            values[r] = column.data_[r][0];
+        return assign_column(name, std::move(values));
+    }
+
+    /**
+     * @fn rename
+     * @brief 列名のリネームメソッド
+     * 
+     * @param std::initializer_list<std::stirng> header リネーム後のヘッダー名のリスト 
+     * @return DataFrame& リネーム後の自身のインスタンス
+     */
+    DataFrame& rename(const std::initializer_list<std::string>& header)
+    {
+        std::vector<std::string> v(header);
+        this->rename(v);
+        return *this;
+    }
+
+    /**
+     * @fn rename
+     * @brief 列名のリネームメソッド
+     * 
+     * @param std::vector<std::stirng> header リネーム後のヘッダー名のリスト 
+     * @return DataFrame& リネーム後の自身のインスタンス
+     */
+    DataFrame& rename(const std::vector<std::string> header)
+    {
+        if(header.size()!=header_.size())
+            throw std::runtime_error("header size is different");
+        header_ = header;
+        return *this;
+    }
+
+    /**
+     * @fn describe
+     * @brief メタ情報取得表示メソッド
+     */ 
+    void describe() const
+    {
+        std::cout << "header names: {" << concat(header_, ",") << "}" << std::endl;
+        std::cout << "    row size: " << data_.size() << std::endl;
+        std::cout << " column size: " << header_.size() << std::endl;
+    }
+
+    /**
+     * @fn statistics
+     * @brief 数値列の統計量の集計メソッド
+     * 
+     * @param enum Execution execution 並列実行モード { AUTO : データ量に応じて自動選択, SEQUENTIAL : 逐次, PARALLEL : 並列 }
+     * @return DataFrame 数値列ごとの統計量 (count, mean, std, min, 25%, 50%, 75%, max) を行に持つDataFrameインスタンス
+     * @note 先頭列 "statistic" に統計量名を格納する。空文字を除く全要素が数値に変換できる列のみを対象とする。
+     * @n    各列は1回の走査で数値変換と統計量の集計を行い、四分位数は変換済みの連続領域に対する部分選択で求める。
+     * @n    列単位で各スレッドに分割して実行する。
+     */
+    DataFrame statistics(const enum Execution& execution=AUTO) const
+    {
+        const std::vector<std::string> names = {"count", "mean", "std", "min", "25%", "50%", "75%", "max"};
+        std::vector<std::vector<std::string>> summary(header_.size());
+        parallel_for(header_.size(), thread_size(execution, data_.size() * header_.size()), [&](const std::size_t& begin, const std::size_t& end)
+        {
+            std::vector<double> values;
+            for(auto c = begin; c < end; c++)
+            {
+                values.clear();
+                values.reserve(data_.size());
+                bool numeric = true;
+                double value, mean = 0.0, m2 = 0.0;
+                double lower = std::numeric_limits<double>::infinity(), upper = -lower;
+                for(const auto& row : data_)
+                {
+                    if(row[c].empty())
+                        continue;
+                    if(!to_number(row[c], value))
+                    {
+                        numeric = false;
+                        break;
+                    }
+                    values.push_back(value);
+                    const double delta = value - mean;
+                    mean += delta / values.size();
+                    m2   += delta * (value - mean);
+                    lower = (std::min)(lower, value);
+                    upper = (std::max)(upper, value);
+                }
+                if(!numeric || values.empty())
+                    continue;
+
+                const auto n = values.size();
+                const auto q = quantiles(values, {0.25, 0.5, 0.75});
+                summary[c] = {
+                    std::to_string(n),
+                    format_number(mean),
+                    n > 1 ? format_number(std::sqrt(m2 / (n - 1))) : std::string(),
+                    format_number(lower),
+                    format_number(q[0]),
+                    format_number(q[1]),
+                    format_number(q[2]),
+                    format_number(upper)
+                };
+            }
+        });
+
+        std::vector<std::string> header = {"statistic"};
+        for(std::size_t c = 0; c < header_.size(); c++)
+            if(!summary[c].empty())
+                header.push_back(header_[c]);
+
+        std::vector<std::vector<std::string>> data;
+        for(std::size_t i = 0; i < names.size(); i++)
+        {
+            std::vector<std::string> row = {names[i]};
+            for(const auto& column : summary)
+                if(!column.empty())
+                    row.push_back(column[i]);
+            data.push_back(row);
+        }
+
+        return DataFrame(std::move(header), std::move(data));
+    }
+
+    /**
+     * @fn memory_usage
+     * @brief 列ごとのメモリ使用量を取得するメソッド
+     * 
+     * @param bool deep 文字列がヒープに確保している領域まで計上するか
+     * @return MemoryUsage 列ごとの使用バイト数とDataFrame全体の内訳
+     * @note SSO(Small String Optimization)によりオブジェクト内に収まっている文字列はヒープ領域として計上しない。
+     * @n    アロケータの管理領域は1回の確保につき16バイト境界への切り上げとヘッダー8バイトとして推定する。
+     */
+    MemoryUsage memory_usage(const bool& deep=false) const
+    {
+        MemoryUsage result;
+        result.column          = header_;
+        result.inline_bytes    = std::vector<std::size_t>(header_.size(), 0);
+        result.heap_bytes      = std::vector<std::size_t>(header_.size(), 0);
+        result.container_bytes = sizeof(*this) + header_.capacity() * sizeof(std::string) + data_.capacity() * sizeof(std::vector<std::string>);
+        result.overhead_bytes  = allocation_overhead(header_.capacity() * sizeof(std::string))
+                               + allocation_overhead(data_.capacity() * sizeof(std::vector<std::string>));
+
+        if(deep)
+        {
+            for(const auto& name : header_)
+            {
+                if(!is_heap_allocated(name))
+                    continue;
+                result.container_bytes += name.capacity() + 1;
+                result.overhead_bytes  += allocation_overhead(name.capacity() + 1);
+            }
+        }
+
+        for(const auto& row : data_)
+        {
+            result.container_bytes += (row.capacity() - row.size()) * sizeof(std::string);
+            result.overhead_bytes  += allocation_overhead(row.capacity() * sizeof(std::string));
+            for(std::size_t c = 0; c < row.size(); c++)
+            {
+                result.inline_bytes[c] += sizeof(std::string);
+                if(!deep || !is_heap_allocated(row[c]))
+                    continue;
+                result.heap_bytes[c]  += row[c].capacity() + 1;
+                result.overhead_bytes += allocation_overhead(row[c].capacity() + 1);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @fn count
+     * @brief 列ごとの欠損(空文字)でない要素数を集計するメソッド
+     * 
+     * @return DataFrame 各列の集計結果を1行に持つDataFrameインスタンス
+     */
+    DataFrame count() const
+    {
+        std::vector<std::string> result(header_.size());
+        for(std::size_t c = 0; c < header_.size(); c++)
+        {
+            std::size_t n = 0;
+            for(const auto& row : data_)
+                n += !row[c].empty();
+            result[c] = std::to_string(n);
+        }
+        return DataFrame(header_, {result});
+    }
+
+    /**
+     * @fn sum
+     * @brief 列ごとの合計値を集計するメソッド
+     * 
+     * @param enum Execution execution 並列実行モード { AUTO : データ量に応じて自動選択, SEQUENTIAL : 逐次, PARALLEL : 並列 }
+     * @return DataFrame 各列の集計結果を1行に持つDataFrameインスタンス (数値要素がない列は空文字)
+     * @note 数値に変換できない要素は欠損として集計対象から除外する。以下の集計メソッドも同様。
+     * @n    1列のDataFrameに対して呼び出した場合は double s = df["col"].sum(); のようにそのまま代入できる。
+     */
+    DataFrame sum(const enum Execution& execution=AUTO) const
+    {
+        return aggregate(execution, false, [](const Moments& m) { return m.count ? format_number(m.sum) : std::string(); });
+    }
+
+    /**
+     * @fn mean
+     * @brief 列ごとの平均値を集計するメソッド
+     * 
+     * @param enum Execution execution 並列実行モード
+     * @return DataFrame 各列の集計結果を1行に持つDataFrameインスタンス (数値要素がない列は空文字)
+     */
+    DataFrame mean(const enum Execution& execution=AUTO) const
+    {
+        return aggregate(execution, false, [](const Moments& m) { return m.count ? format_number(m.sum / m.count) : std::string(); });
+    }
+
+    /**
+     * @fn min
+     * @brief 列ごとの最小値を集計するメソッド
+     * 
+     * @param enum Execution execution 並列実行モード
+     * @return DataFrame 各列の集計結果を1行に持つDataFrameインスタンス (数値要素がない列は空文字)
+     */
+    DataFrame (min)(const enum Execution& execution=AUTO) const
+    {
+        return aggregate(execution, false, [](const Moments& m) { return m.count ? format_number(m.min) : std::string(); });
+    }
+
+    /**
+     * @fn max
+     * @brief 列ごとの最大値を集計するメソッド
+     * 
+     * @param enum Execution execution 並列実行モード
+     * @return DataFrame 各列の集計結果を1行に持つDataFrameインスタンス (数値要素がない列は空文字)
+     */
+    DataFrame (max)(const enum Execution& execution=AUTO) const
+    {
+        return aggregate(execution, false, [](const Moments& m) { return m.count ? format_number(m.max) : std::string(); });
+    }
+
+    /**
+     * @fn var
+     * @brief 列ごとの分散を集計するメソッド
+     * 
+     * @param int ddof 自由度の補正値 (pandasと同じく既定値は1の不偏分散)
+     * @param enum Execution execution 並列実行モード
+     * @return DataFrame 各列の集計結果を1行に持つDataFrameインスタンス (要素数がddof以下の列は空文字)
+     */
+    DataFrame var(const int& ddof=1, const enum Execution& execution=AUTO) const
+    {
+        return aggregate(execution, true, [ddof](const Moments& m) 
+        { 
+            return static_cast<int>(m.count) > ddof ? format_number(m.m2 / (m.count - ddof)) : std::string(); 
+        });
+    }
+
+    /**
+     * @fn std
+     * @brief 列ごとの標準偏差を集計するメソッド
+     * 
+     * @param int ddof 自由度の補正値 (pandasと同じく既定値は1)
+     * @param enum Execution execution 並列実行モード
+     * @return DataFrame 各列の集計結果を1行に持つDataFrameインスタンス (要素数がddof以下の列は空文字)
+     */
+    DataFrame std(const int& ddof=1, const enum Execution& execution=AUTO) const
+    {
+        return aggregate(execution, true, [ddof](const Moments& m) 
+        { 
+            return static_cast<int>(m.count) > ddof ? format_number(std::sqrt(m.m2 / (m.count - ddof))) : std::string(); 
+        });
+    }
+
+    /**
+     * @fn merge
+     * @brief キー列による他のDataFrameとの結合メソッド
+     * 
+     * @param DataFrame other 結合相手のDataFrameインスタンス
+     * @param std::vector<std::string> on 結合キーとする列名のリスト (両方のDataFrameに存在すること)
+     * @param enum Join how 結合方法 { INNER, LEFT, RIGHT, OUTER, SEMI, ANTI }
+     * @param enum JoinAlgorithm algorithm 結合アルゴリズム { AUTO_JOIN : INNER, LEFT, SEMI, ANTI で両方がキー順に並んでいればソートマージ結合、それ以外はハッシュ結合, HASH_JOIN, SORT_MERGE_JOIN }
+     * @return DataFrame 結合後の新たなDataFrameインスタンス
+     * @note ハッシュ結合では行数の少ない側のキーでハッシュテーブルを構築し、もう一方のキーのハッシュ値を一括計算してから探索する。
+     * @n    ソートマージ結合では両方をキー順に1回ずつ走査する。キー順に並んでいない場合は行インデックスを並べ替えてから走査する。
+     * @n    キーの大小は両方が数値であれば数値として、それ以外は文字列として比較し、空文字は末尾とする。(sort_values の昇順と同じ並び)
+     * @n    AUTO_JOIN の並び順の確認は両方を先頭から交互に走査し、一方が並んでいなければその位置で打ち切る。
+     * @n    結果の列は自身の全列の後に相手のキー以外の列を並べる。キー以外で同名の列は "_x", "_y" を付加する。
+     * @n    SEMI, ANTI は自身の列のみを返す。ハッシュ結合の結果は自身の行順 (RIGHT は相手の行順) に並び、OUTER は相手側のみの行を末尾に置く。
+     * @n    ソートマージ結合の結果はキー順に並ぶ。(SEMI, ANTI は自身の行順)
+     * @n    AUTO_JOIN は結果の行順がハッシュ結合と一致する場合 (両方がキー順の INNER, LEFT, SEMI, ANTI) のみソートマージ結合を選択するため、
+     * @n    既定の結合方法では入力の並び順によらず同じ行順の結果となる。
+     */
+    DataFrame merge(const DataFrame& other, const std::vector<std::string>& on, const enum Join& how=INNER, const enum JoinAlgorithm& algorithm=AUTO_JOIN) const
+    {
+        const auto left_keys  = indices_of(on);
+        const auto right_keys = other.indices_of(on);
+        if(algorithm == SORT_MERGE_JOIN)
+            return join_frame(other, left_keys, right_keys, sort_merge_join(other, left_keys, right_keys, how, is_sorted_by(left_keys), other.is_sorted_by(right_keys)), how);
+        // AUTO_JOIN uses sort-merge only where its row order matches the hash join
+        const bool same_order = how == INNER || how == LEFT || how == SEMI || how == ANTI;
+        if(algorithm == AUTO_JOIN && same_order && is_sorted_with(other, left_keys, right_keys))
+            return join_frame(other, left_keys, right_keys, sort_merge_join(other, left_keys, right_keys, how, true, true), how);
+        return join_frame(other, left_keys, right_keys, hash_join(other, left_keys, right_keys, how), how);
+    }
+
+    /**
+     * @fn merge_asof
+     * @brief 時系列の近傍結合メソッド (自身の各行に、時刻が同じかそれ以前で最も新しい相手の行を結合する)
+     * 
+     * @param DataFrame other 結合相手のDataFrameインスタンス
+     * @param std::string on 時刻の列名 (両方に存在し、数値で昇順に並んでいること)
+     * @param std::vector<std::string> by 完全一致させるグループの列名のリスト
+     * @param double tolerance 許容する時刻の差 (これより離れた行は結合しない)
+     * @return DataFrame 結合後の新たなDataFrameインスタンス (自身の行順で、結合相手がない行の相手側の列は空文字)
+     * @note 両方の時刻の列を1回ずつ走査する線形マージで求める。列の並びは @ref merge の LEFT と同じ。
+     */
+    DataFrame merge_asof(const DataFrame& other, const std::string& on, const std::vector<std::string>& by={}, const double& tolerance=std::numeric_limits<double>::infinity()) const
+    {
+        const std::size_t npos = KeyIndex::npos;
+        const auto left_time  = sorted_times(on);
+        const auto right_time = other.sorted_times(on);
+        const auto left_by    = indices_of(by);
+        const auto right_by   = other.indices_of(by);
+
+        KeyIndex index(other.data_, right_by);
+        std::vector<std::size_t> latest;
+        RowPairs pairs;
+        pairs.reserve(data_.size());
+        std::size_t j = 0;
+        for(std::size_t l = 0; l < data_.size(); l++)
+        {
+            for(; j < right_time.size() && right_time[j] <= left_time[l]; j++)
+            {
+                const std::size_t id = index.insert(j, row_hash(other.data_[j], right_by));
+                if(id == latest.size())
+                    latest.push_back(j);
+                latest[id] = j;
+            }
+            const std::size_t id = index.find(data_[l], left_by, row_hash(data_[l], left_by));
+            const bool matched   = id != npos && left_time[l] - right_time[latest[id]] <= tolerance;
+            pairs.push_back(std::make_pair(l, matched ? latest[id] : npos));
+        }
+
+        std::vector<std::size_t> left_keys  = {index_of(on)};
+        std::vector<std::size_t> right_keys = {other.index_of(on)};
+        left_keys.insert(left_keys.end(), left_by.begin(), left_by.end());
+        right_keys.insert(right_keys.end(), right_by.begin(), right_by.end());
+        return join_frame(other, left_keys, right_keys, pairs, LEFT);
+    }
+
+    /**
+     * @fn sort_values
+     * @brief 列の値による行の並べ替えメソッド
+     * 
+     * @param std::vector<std::string> columns 並べ替えのキーとする列名のリスト (先頭ほど優先)
+     * @param bool ascending 昇順とするか
+     * @param enum Execution execution 並列実行モード { AUTO : データ量に応じて自動選択, SEQUENTIAL : 逐次, PARALLEL : 並列 }
+     * @return DataFrame 並べ替え後の新たなDataFrameインスタンス
+     * @note 安定ソートであり、キーが等しい行は元の行順を保つ (並列実行時も同様)。空文字の要素は昇順・降順いずれの場合も末尾に置く。
+     */
+    DataFrame sort_values(const std::vector<std::string>& columns, const bool& ascending=true, const enum Execution& execution=AUTO) const
+    {
+        return sort_values(columns, std::vector<bool>(columns.size(), ascending), execution);
+    }
+
+    /**
+     * @fn sort_values
+     * @brief 列の値による行の並べ替えメソッド
+     * 
+     * @param std::vector<std::string> columns 並べ替えのキーとする列名のリスト (先頭ほど優先)
+     * @param std::vector<bool> ascending キーごとに昇順とするか
+     * @param enum Execution execution 並列実行モード { AUTO : データ量に応じて自動選択, SEQUENTIAL : 逐次, PARALLEL : 並列 }
+     * @return DataFrame 並べ替え後の新たなDataFrameインスタンス
+     * @note 各キー列を順序を保つ64bit整数に正規化し (数値列はIEEE754のビット列を変換、文字列列は値の順位)、
+     * @n    LSD基数ソートで行インデックスの並びを求めた後、1回の取り出しで並べ替える。
+     * @n    並列実行時は行を分割して各スレッドで基数ソートした後、区間を分割した並列マージを繰り返して安定に統合する。
+     */
+    DataFrame sort_values(const std::vector<std::string>& columns, const std::vector<bool>& ascending, const enum Execution& execution=AUTO) const
+    {
+        if(columns.size() != ascending.size())
+            throw std::runtime_error("size of ascending must be same as size of columns.");
+
+        const std::size_t threads = thread_size(execution, data_.size());
+        const auto order = sort_order(sort_keys(indices_of(columns), ascending, threads), threads);
+        std::vector<std::vector<std::string>> data;
+        data.reserve(order.size());
+        for(const auto& r : order)
+            data.push_back(data_[r]);
+        return DataFrame(header_, std::move(data));
+    }
+
+    /**
+     * @fn nlargest
+     * @brief 指定列の値が大きい順に上位n行を取り出すメソッド
+     * 
+     * @param int n 取り出す行数
+     * @param std::string column 対象の列名
+     * @param std::vector<std::string> by 指定した場合はこれらの列によるグループごとに上位n行を取り出す
+     * @return DataFrame 取り出した行を持つ新たなDataFrameインスタンス (グループは初出順、グループ内は値の大きい順)
+     * @note 全体のソートは行わず、std::nth_element (グループごとの場合は大きさnのヒープ) による部分選択で求める。
+     * @n    数値に変換できない要素の行は対象外とし、値が等しい場合は元の行順が先の行を優先する。
+     */
+    DataFrame nlargest(const int& n, const std::string& column, const std::vector<std::string>& by={}) const
+    {
+        return select_top(n, index_of(column), indices_of(by), true);
+    }
+
+    /**
+     * @fn nsmallest
+     * @brief 指定列の値が小さい順に上位n行を取り出すメソッド
+     * 
+     * @param int n 取り出す行数
+     * @param std::string column 対象の列名
+     * @param std::vector<std::string> by 指定した場合はこれらの列によるグループごとに上位n行を取り出す
+     * @return DataFrame 取り出した行を持つ新たなDataFrameインスタンス (グループは初出順、グループ内は値の小さい順)
+     * @note 部分選択の方法は @ref nlargest と同じ。
+     */
+    DataFrame nsmallest(const int& n, const std::string& column, const std::vector<std::string>& by={}) const
+    {
+        return select_top(n, index_of(column), indices_of(by), false);
+    }
+
+    /**
+     * @fn cumsum
+     * @brief 数値列の累積和を返す
+     * @note 数値に変換できない要素は空文字のままとし、累積の対象から除外する。
+     * @n    大きな列は行を分割し、各範囲の合計を求めた後にその前置和から各範囲を再走査する2パスの並列スキャンで計算する。
+     * 
+     * @param enum Execution execution 並列実行モード { AUTO : データ量に応じて自動選択, SEQUENTIAL : 逐次, PARALLEL : 並列 }
+     * @return DataFrame 数値列の累積和
+     */
+    DataFrame cumsum(const enum Execution& execution=AUTO) const
+    {
+        return cumulative(execution, 0.0, [](const double& a, const double& b) { return a + b; });
+    }
+
+    /**
+     * @fn cumprod
+     * @brief 数値列の累積積を返す
+     * 
+     * @param enum Execution execution 並列実行モード
+     * @return DataFrame 数値列の累積積
+     */
+    DataFrame cumprod(const enum Execution& execution=AUTO) const
+    {
+        return cumulative(execution, 1.0, [](const double& a, const double& b) { return a * b; });
+    }
+
+    /**
+     * @fn cummax
+     * @brief 数値列の累積最大値を返す
+     * 
+     * @param enum Execution execution 並列実行モード
+     * @return DataFrame 数値列の累積最大値
+     */
+    DataFrame cummax(const enum Execution& execution=AUTO) const
+    {
+        return cumulative(execution, -std::numeric_limits<double>::infinity(), [](const double& a, const double& b) { return (std::max)(a, b); });
+    }
+
+    /**
+     * @fn cummin
+     * @brief 数値列の累積最小値を返す
+     * 
+     * @param enum Execution execution 並列実行モード
+     * @return DataFrame 数値列の累積最小値
+     */
+    DataFrame cummin(const enum Execution& execution=AUTO) const
+    {
+        return cumulative(execution, std::numeric_limits<double>::infinity(), [](const double& a, const double& b) { return (std::min)(a, b); });
+    }
+
+    /**
+     * @fn diff
+     * @brief 数値列の periods 行前との差を返す
+     * @note 比較対象の行が存在しない場合、またはいずれかが数値でない場合は空文字とする。
+     * 
+     * @param int periods 比較する行の間隔 (負数の場合は後の行と比較する)
+     * @param enum Execution execution 並列実行モード
+     * @return DataFrame 数値列の差分
+     */
+    DataFrame diff(const int& periods=1, const enum Execution& execution=AUTO) const
+    {
+        return difference(periods, execution, [](const double& current, const double& previous, double& result)
+        {
+            result = current - previous;
+            return true;
+        });
+    }
+
+    /**
+     * @fn pct_change
+     * @brief 数値列の periods 行前からの変化率を返す
+     * @note 比較対象が0の場合は空文字とする。
+     * 
+     * @param int periods 比較する行の間隔 (負数の場合は後の行と比較する)
+     * @param enum Execution execution 並列実行モード
+     * @return DataFrame 数値列の変化率
+     */
+    DataFrame pct_change(const int& periods=1, const enum Execution& execution=AUTO) const
+    {
+        return difference(periods, execution, [](const double& current, const double& previous, double& result)
+        {
+            if(previous == 0.0)
+                return false;
+            result = current / previous - 1.0;
+            return true;
+        });
+    }
+
+    /**
+     * @fn window
+     * @brief パーティション単位の窓関数の生成メソッド
+     * 
+     * @param std::vector<std::string> partition_by パーティションを定める列名
+     * @param std::vector<std::string> order_by パーティション内の順序を定める列名
+     * @param bool ascending true : 昇順 false : 降順
+     * @param enum Execution execution 並べ替えの並列実行モード { AUTO : データ量に応じて自動選択, SEQUENTIAL : 逐次, PARALLEL : 並列 }
+     * @return Window 窓関数用インスタンス (row_number, rank, dense_rank, lag, lead, shift で計算する)
+     * @note パーティション内の順序は @ref sort_values と同じ比較による。(順序が等しい行は元の行順)
+     */
+    Window window(const std::vector<std::string>& partition_by, const std::vector<std::string>& order_by, const bool& ascending=true, const enum Execution& execution=AUTO) const
+    {
+        auto columns = indices_of(partition_by);
+        const auto orders = indices_of(order_by);
+        columns.insert(columns.end(), orders.begin(), orders.end());
+        std::vector<bool> directions(columns.size(), true);
+        std::fill(directions.begin() + partition_by.size(), directions.end(), ascending);
+
+        const std::size_t threads = thread_size(execution, data_.size());
+        const auto keys = sort_keys(columns, directions, threads);
+        auto order = sort_order(keys, threads);
+
+        std::vector<std::size_t> start(order.size());
+        std::vector<bool> peer(order.size(), true);
+        for(std::size_t p = 1; p < order.size(); p++)
+        {
+            const std::size_t current = order[p], previous = order[p - 1];
+            std::size_t k = 0;
+            while(k < partition_by.size() && keys[k][current] == keys[k][previous])
+                k++;
+            start[p] = k < partition_by.size() ? p : start[p - 1];
+            if(k < partition_by.size())
+                continue;
+            while(k < keys.size() && keys[k][current] == keys[k][previous])
+                k++;
+            peer[p] = k < keys.size();
+        }
+        return Window(*this, std::move(order), std::move(start), std::move(peer));
+    }
+
+    /**
+     * @fn rolling
+     * @brief 行数による移動窓の生成メソッド
+     * 
+     * @param int window 窓の行数
+     * @param int min_periods 結果を出力する窓内の最小要素数 (負数の場合は window と同じ)
+     * @return Rolling 移動窓集計用インスタンス (sum, mean, min, max, var, std で集計する)
+     */
+    Rolling rolling(const int& window, const int& min_periods=-1) const
+    {
+        if(window <= 0)
+            throw std::out_of_range("window must be positive.");
+        return Rolling(*this, window, 0.0, std::string(), min_periods < 0 ? window : min_periods);
+    }
+
+    /**
+     * @fn rolling
+     * @brief 時刻による移動窓の生成メソッド
+     * 
+     * @param double duration 窓の時間幅 (時刻 t の行の窓は (t - duration, t] の行)
+     * @param std::string on 時刻の列名 (数値で昇順に並んでいること)
+     * @param int min_periods 結果を出力する窓内の最小要素数
+     * @return Rolling 移動窓集計用インスタンス (結果には時刻の列も含む)
+     */
+    Rolling rolling(const double& duration, const std::string& on, const int& min_periods=1) const
+    {
+        if(duration <= 0.0)
+            throw std::out_of_range("duration must be positive.");
+        return Rolling(*this, 0, duration, on, min_periods);
+    }
+
+    /**
+     * @fn ewm
+     * @brief 指数加重移動統計の生成メソッド
+     * 
+     * @param double value 減衰パラメータの値
+     * @param enum Decay decay 減衰パラメータの種類 { ALPHA, SPAN, COM, HALFLIFE }
+     * @param bool adjust true の場合は初期の重みを補正する
+     * @return Ewm 指数加重移動統計用インスタンス (mean, var で集計する)
+     */
+    Ewm ewm(const double& value, const enum Decay& decay=ALPHA, const bool& adjust=true) const
+    {
+        Ewm ewm(value, decay, adjust);
+        ewm.frame_ = this;
+        return ewm;
+    }
+
+    /**
+     * @fn quantile
+     * @brief 列ごとの分位点を求めるメソッド
+     * 
+     * @param double q 分位点 (0 <= q <= 1)
+     * @param bool approximate true の場合は @ref QuantileSketch による近似値を求める (全体の並べ替えや値の複製を行わない)
+     * @param enum Execution execution 並列実行モード { AUTO : データ量に応じて自動選択, SEQUENTIAL : 逐次, PARALLEL : 並列 }
+     * @return DataFrame 各列の分位点を1行に持つDataFrameインスタンス (数値が存在しない列は空文字)
+     * @note 厳密値は線形補間による。(pandasの既定の補間方法と同じ)
+     * @n    近似値の並列実行時は行を分割して各スレッドでスケッチを作成し、統合して求める。
+     */
+    DataFrame quantile(const double& q, const bool& approximate=false, const enum Execution& execution=AUTO) const
+    {
+        if(!(q >= 0.0 && q <= 1.0))
+            throw std::out_of_range("q must be in [0, 1].");
+
+        std::vector<std::string> result(header_.size());
+        for(std::size_t c = 0; c < header_.size(); c++)
+        {
+            if(approximate)
+            {
+                const auto sketch = quantile_sketch(c, execution);
+                if(sketch.count())
+                    result[c] = format_number(sketch.quantile(q));
+                continue;
+            }
+            std::vector<double> values;
+            double value;
+            for(const auto& row : data_)
+                if(to_number(row[c], value))
+                    values.push_back(value);
+            if(!values.empty())
+                result[c] = format_number(quantiles(values, {q}).front());
+        }
+        return DataFrame(header_, {result});
+    }
+
+    /**
+     * @fn quantile_sketch
+     * @brief 列の @ref QuantileSketch を作成するメソッド
+     * @note 作成したスケッチは QuantileSketch::merge により他のバッチのスケッチと統合できる。
+     * 
+     * @param std::string column 対象の列名
+     * @param enum Execution execution 並列実行モード
+     * @return QuantileSketch 列の数値を追加したスケッチ
+     */
+    QuantileSketch quantile_sketch(const std::string& column, const enum Execution& execution=AUTO) const
+    {
+        return quantile_sketch(index_of(column), execution);
+    }
+
+    /**
+     * @fn nunique
+     * @brief 列ごとの異なり数を求めるメソッド
+     * 
+     * @param bool approximate true の場合は @ref DistinctSketch による近似値を求める (固定サイズのメモリで済む)
+     * @param enum Execution execution 近似値の並列実行モード { AUTO : データ量に応じて自動選択, SEQUENTIAL : 逐次, PARALLEL : 並列 }
+     * @return DataFrame 各列の異なり数を1行に持つDataFrameインスタンス
+     * @note 空文字の要素は除外する。近似値の並列実行時は行を分割して各スレッドでスケッチを作成し、統合して求める。
+     */
+    DataFrame nunique(const bool& approximate=false, const enum Execution& execution=AUTO) const
+    {
+        std::vector<std::string> result(header_.size());
+        for(std::size_t c = 0; c < header_.size(); c++)
+        {
+            if(approximate)
+            {
+                result[c] = std::to_string(static_cast<std::uint64_t>(std::llround(distinct_sketch(c, execution).estimate())));
+                continue;
+            }
+            const std::vector<std::size_t> columns = {c};
+            KeyIndex index(data_, columns);
+            for(std::size_t r = 0; r < data_.size(); r++)
+                if(!data_[r][c].empty())
+                    index.insert(r, hash_string(data_[r][c]));
+            result[c] = std::to_string(index.size());
+        }
+        return DataFrame(header_, {result});
+    }
+
+    /**
+     * @fn distinct_sketch
+     * @brief 列の @ref DistinctSketch を作成するメソッド
+     * @note 作成したスケッチは DistinctSketch::merge により他のバッチのスケッチと統合できる。
+     * 
+     * @param std::string column 対象の列名
+     * @param enum Execution execution 並列実行モード
+     * @return DistinctSketch 列の要素を追加したスケッチ
+     */
+    DistinctSketch distinct_sketch(const std::string& column, const enum Execution& execution=AUTO) const
+    {
+        return distinct_sketch(index_of(column), execution);
+    }
+
+    /**
+     * @fn unique
+     * @brief 重複を除いた行を初出順に返すメソッド
+     * @note 空文字を含む行も1つの値の組として扱う。1列のDataFrameであれば列の値の一覧となる。
+     * 
+     * @return DataFrame 重複を除いた行を持つDataFrameインスタンス
+     */
+    DataFrame unique() const
+    {
+        std::vector<std::int64_t> codes;
+        const auto rows = factorize_rows(all_columns(), codes, false);
+        std::vector<std::vector<std::string>> data;
+        data.reserve(rows.size());
+        for(const auto& r : rows)
+            data.push_back(data_[r]);
+        return DataFrame(header_, std::move(data));
+    }
+
+    /**
+     * @fn factorize
+     * @brief 行の値の組に初出順の整数コードを割り当てるメソッド
+     * @note 空文字を含む行のコードは -1 とする。コードを再利用することで、後続の集計・結合等で文字列を再度ハッシュせずに済む。
+     * 
+     * @return std::pair<std::vector<std::int64_t>, DataFrame> 各行のコードと、コード順に並べた値の組を持つDataFrameインスタンスの組
+     */
+    std::pair<std::vector<std::int64_t>, DataFrame> factorize() const
+    {
+        std::vector<std::int64_t> codes;
+        const auto rows = factorize_rows(all_columns(), codes);
+        std::vector<std::vector<std::string>> data;
+        data.reserve(rows.size());
+        for(const auto& r : rows)
+            data.push_back(data_[r]);
+        return std::make_pair(std::move(codes), DataFrame(header_, std::move(data)));
+    }
+
+    /**
+     * @fn duplicated
+     * @brief 重複した行を表す選択マスクを返すメソッド
+     * @note 行のハッシュ値を列単位でまとめて求め、ハッシュ値が一致した行同士のみ値を比較する。空文字も1つの値として扱う。
+     * 
+     * @param std::vector<std::string> subset 比較対象の列名 (空の場合は全列)
+     * @param enum Keep keep 重複として扱わない行 { KEEP_FIRST : 最初の出現, KEEP_LAST : 最後の出現, KEEP_NONE : なし (重複する全ての行) }
+     * @return Mask 重複した行が真となる選択マスク
+     */
+    Mask duplicated(const std::vector<std::string>& subset={}, const enum Keep& keep=KEEP_FIRST) const
+    {
+        const auto columns = subset.empty() ? all_columns() : indices_of(subset);
+        const auto hashes  = row_hashes(columns, AUTO);
+        KeyIndex index(data_, columns);
+        std::vector<std::size_t> codes(data_.size());
+        for(std::size_t r = 0; r < data_.size(); r++)
+            codes[r] = index.insert(r, hashes[r]);
+
+        std::vector<std::size_t> keeper(index.size());
+        if(keep == KEEP_FIRST)
+            keeper = index.rows();
+        else if(keep == KEEP_LAST)
+            for(std::size_t r = 0; r < data_.size(); r++)
+                keeper[codes[r]] = r;
+        else
+        {
+            std::vector<std::size_t> counts(index.size(), 0);
+            for(const auto& code : codes)
+                counts[code]++;
+            for(std::size_t id = 0; id < keeper.size(); id++)
+                keeper[id] = counts[id] == 1 ? index.rows()[id] : KeyIndex::npos;
+        }
+
+        std::vector<bool> mask(data_.size());
+        for(std::size_t r = 0; r < data_.size(); r++)
+            mask[r] = keeper[codes[r]] != r;
+        return Mask(mask);
+    }
+
+    /**
+     * @fn drop_duplicates
+     * @brief 重複した行を除いたDataFrameを返すメソッド
+     * 
+     * @param std::vector<std::string> subset 比較対象の列名 (空の場合は全列)
+     * @param enum Keep keep 残す行 { KEEP_FIRST : 最初の出現, KEEP_LAST : 最後の出現, KEEP_NONE : 重複のない行のみ }
+     * @return DataFrame 重複を除いた行を元の行順で持つDataFrameインスタンス
+     */
+    DataFrame drop_duplicates(const std::vector<std::string>& subset={}, const enum Keep& keep=KEEP_FIRST) const
+    {
+        return filter(~duplicated(subset, keep));
+    }
+
+    /**
+     * @fn hash_rows
+     * @brief 行ごとの64bitハッシュ値を返すメソッド (非暗号学的ハッシュ)
+     * @note 列単位でまとめて求め、大きなDataFrameは行を分割して並列に求める。同じ値の組の行は同じハッシュ値となる。
+     * 
+     * @param std::vector<std::string> subset 対象の列名 (空の場合は全列)
+     * @param enum Execution execution 並列実行モード { AUTO : データ量に応じて自動選択, SEQUENTIAL : 逐次, PARALLEL : 並列 }
+     * @return std::vector<std::uint64_t> 各行のハッシュ値
+     */
+    std::vector<std::uint64_t> hash_rows(const std::vector<std::string>& subset={}, const enum Execution& execution=AUTO) const
+    {
+        return row_hashes(subset.empty() ? all_columns() : indices_of(subset), execution);
+    }
+
+    /**
+     * @fn checksum
+     * @brief DataFrame全体の64bitチェックサムを返すメソッド (非暗号学的ハッシュ)
+     * @note 列名・行数・各行のハッシュ値を順に結合するため、行の並び順も結果に影響する。変更検知に使用できる。
+     * 
+     * @param enum Execution execution 行のハッシュ値の並列実行モード
+     * @return std::uint64_t チェックサム
+     */
+    std::uint64_t checksum(const enum Execution& execution=AUTO) const
+    {
+        std::uint64_t h = hash_combine(0, header_.size());
+        for(const auto& name : header_)
+            h = hash_combine(h, hash_string(name));
+        h = hash_combine(h, data_.size());
+        for(const auto& row : row_hashes(all_columns(), execution))
+            h = hash_combine(h, row);
+        return mix(h);
+    }
+
+    /**
+     * @fn value_counts
+     * @brief 行の値の組ごとの出現回数を求めるメソッド
+     * 
+     * @param std::size_t top 0より大きい場合は出現回数の多い上位 top 件のみを返す
+     * @param bool approximate true の場合は @ref HeavyHitters による近似値を有界なメモリで求める
+     * @param enum Execution execution 近似値の並列実行モード { AUTO : データ量に応じて自動選択, SEQUENTIAL : 逐次, PARALLEL : 並列 }
+     * @param std::string name 出現回数の列名 (既存の列名と重複する場合は例外を送出する)
+     * @return DataFrame 各列と出現回数の列 (既定値 "count") を持つDataFrameインスタンス (出現回数の多い順)
+     * @note 空文字を含む行は除外する。厳密値で出現回数が等しい場合は初出順に並ぶ。
+     * @n    近似値は max(1024, 10 * top) 個のカウンタで求め、出現回数は真の値以上の推定値となる。
+     * @n    並列実行時は行を分割して各スレッドでスケッチを作成し、統合して求める。
+     */
+    DataFrame value_counts(const std::size_t& top=0, const bool& approximate=false, const enum Execution& execution=AUTO, const std::string& name="count") const
+    {
+        if(std::find(header_.begin(), header_.end(), name) != header_.end())
+            throw std::runtime_error("column '" + name + "' already exists.");
+        std::vector<std::string> header = header_;
+        header.push_back(name);
+        std::vector<std::vector<std::string>> data;
+        const auto columns = all_columns();
+        if(approximate)
+        {
+            const auto sketch = heavy_hitters(columns, std::max<std::size_t>(1024, top * 10), execution);
+            for(const auto& item : sketch.top(top))
+            {
+                auto row = decode_row(item.first, columns.size());
+                row.push_back(std::to_string(item.second));
+                data.push_back(std::move(row));
+            }
+            return DataFrame(std::move(header), std::move(data));
+        }
+
+        std::vector<std::int64_t> codes;
+        const auto rows = factorize_rows(columns, codes);
+        std::vector<std::size_t> counts(rows.size(), 0);
+        for(const auto& code : codes)
+            if(code >= 0)
+                counts[static_cast<std::size_t>(code)]++;
+        std::vector<std::size_t> ids(counts.size());
+        for(std::size_t id = 0; id < ids.size(); id++)
+            ids[id] = id;
+        std::stable_sort(ids.begin(), ids.end(), [&counts](const std::size_t& a, const std::size_t& b) { return counts[a] > counts[b]; });
+        if(top && ids.size() > top)
+            ids.resize(top);
+        for(const auto& id : ids)
+        {
+            auto row = data_[rows[id]];
+            row.push_back(std::to_string(counts[id]));
+            data.push_back(std::move(row));
+        }
+        return DataFrame(std::move(header), std::move(data));
+    }
+
+    /**
+     * @fn heavy_hitters
+     * @brief 列の @ref HeavyHitters を作成するメソッド
+     * @note 作成したスケッチは HeavyHitters::merge により他のバッチのスケッチと統合できる。
+     * 
+     * @param std::string column 対象の列名
+     * @param std::size_t capacity 保持するカウンタの数
+     * @param enum Execution execution 並列実行モード
+     * @return HeavyHitters 列の要素 (空文字を除く) を追加したスケッチ
+     */
+    HeavyHitters heavy_hitters(const std::string& column, const std::size_t& capacity=1024, const enum Execution& execution=AUTO) const
+    {
+        return heavy_hitters(std::vector<std::size_t>(1, index_of(column)), capacity, execution);
+    }
+
+    /**
+     * @fn groupby
+     * @brief キー列によるグループ化メソッド
+     * 
+     * @param std::vector<std::string> keys キーとする列名のリスト
+     * @return GroupBy グループ集計用インスタンス
+     * @note キー列のいずれかが空文字の行は集計対象から除外する。(pandasの dropna=True と同じ)
+     * @n    --例-- df.groupby({"month"}).agg({{"tempature", DataFrame::SUM}, {"tempature", DataFrame::MAX}});
+     */
+    GroupBy groupby(const std::vector<std::string>& keys) const
+    {
+        if(keys.empty())
+            throw std::runtime_error("groupby keys must not be empty.");
+        return GroupBy(*this, indices_of(keys));
+    }
+
+    /**
+     * @fn data
+     * @brief データ取り出しメソッド
+     *  
+     * @return std::vector<std::vector<std::string> data 
+     */
+    std::vector<std::vector<std::string>> data() const
+    {
+        return data_;
+    }
+
+    /**
+     * @fn to_matrix
+     * @brief 2次元ベクターに変換するメソッド
+     * 
+     * @tparam T 
+     * @return std::vector<T> 
+     */
+    template<typename T>
+    std::vector<std::vector<T>> to_matrix() const
+    {
+        std::vector<std::vector<T>> result;
+        std::vector<T> tmp;
+        result.reserve(data_.size());
+        for(const auto& line : data_)
+        {
+            tmp.clear();
+            tmp.reserve(line.size());
+            for(const auto& e : line)
+            {
+                tmp.push_back(As<T>::as(e));
+            }
+            result.push_back(tmp);
+        }
+        return result;
+    }
+
+    /**
+     * @fn to_dense
+     * @brief 呼出元が確保した連続領域に行列データを書き込むメソッド
+     * 
+     * @tparam T 
+     * @param T* out 書込先の先頭ポインタ (行数 x 列数 の要素数を確保しておくこと)
+     * @param enum Layout layout 書込順序 { ROW_MAJOR : 行優先, COLUMN_MAJOR : 列優先 }
+     * @param enum Execution execution 並列実行モード { AUTO : データ量に応じて自動選択, SEQUENTIAL : 逐次, PARALLEL : 並列 }
+     * @note 変換は列単位で各スレッドに分割して実行する。BLAS等の数値計算ライブラリへコピーなしで受け渡すことを想定している。
+     */
+    template<typename T>
+    void to_dense(T* out, const enum Layout& layout=ROW_MAJOR, const enum Execution& execution=AUTO) const
+    {
+        if(out == nullptr)
+            throw std::runtime_error("output buffer of to_dense method must not be null.");
+
+        const std::size_t row_size    = data_.size();
+        const std::size_t column_size = header_.size();
+        parallel_for(column_size, thread_size(execution, row_size * column_size), [&](const std::size_t& begin, const std::size_t& end)
+        {
+            for(auto c = begin; c < end; c++)
+            {
+                if(layout == COLUMN_MAJOR)
+                    for(std::size_t r = 0; r < row_size; r++)
+                        out[c * row_size + r] = As<T>::as(data_[r][c]);
+                else // ROW_MAJOR
+                    for(std::size_t r = 0; r < row_size; r++)
+                        out[r * column_size + c] = As<T>::as(data_[r][c]);
+            }
+        });
+    }
+
+    /**
+     * @fn to_dense
+     * @brief 1次元の連続領域に行列データを変換するメソッド
+     * 
+     * @tparam T 
+     * @param enum Layout layout 書込順序 { ROW_MAJOR : 行優先, COLUMN_MAJOR : 列優先 }
+     * @param enum Execution execution 並列実行モード { AUTO : データ量に応じて自動選択, SEQUENTIAL : 逐次, PARALLEL : 並列 }
+     * @return std::vector<T> 行数 x 列数 の要素を持つベクター
+     */
+    template<typename T>
+    std::vector<T> to_dense(const enum Layout& layout=ROW_MAJOR, const enum Execution& execution=AUTO) const
+    {
+        std::vector<T> result(data_.size() * header_.size());
+        if(!result.empty())
+            to_dense(result.data(), layout, execution);
+        return result;
+    }
+
+    /**
+     * @fn to_vector
+     * @brief 列・行いずれかを指定の型の1次元ベクターに変換するメソッド
+     * 
+     * @tparam T 
+     * @param enum Axis axis ベクター化したい軸 { ROW : 行, COLUMN : 列 } 
+     * @return std::vector<T> 
+     */
+    template<typename T>
+    std::vector<T> to_vector(const enum Axis& axis=COLUMN) const
+    {
+        if(axis==ROW && data_.size() != 1)
+            throw std::runtime_error("to_vector method can be used to 1 raw DataFrame only.");
+        if(axis==COLUMN && header_.size() != 1)
+            throw std::runtime_error("to_vector method can be used to 1 column DataFrame only.");
+        
+        std::vector<T> result;
+        if(axis==COLUMN)
+            for(const auto& row : data_)
+                result.push_back(As<T>::as(row[0]));
+        else // ROW
+            for(const auto& e : data_[0])
+                result.push_back(As<T>::as(e));
+        return result;
+    } 
+
+    /**
+     * @fn as
+     * @brief 1行・1列のDataFrameインスタンスを特定の型に変換する
+     * 
+     * @tparam T 
+     * @return T 取得したい型に変換したデータ返却する
+     */
+    template<typename T>
+    T as() const
+    {
+        if(data_.size() != 1 || data_.at(0).size() != 1)
+        {
+            throw std::runtime_error("as method can be used to 1 raw and 1 column DataFrame only.");
+        }
+
+        return As<T>::as(data_[0][0]);
+    }
+
+    operator int() const
+    {
+        return as<int>();
+    }
+
+    operator double() const
+    {
+        return as<double>();
+    }
+
+    operator std::string() const
+    {
+        return as<std::string>();
+    }
+
+    operator std::vector<int>() const
+    {
+        if(data_.size() == 1)
+            return to_vector<int>(ROW);
+        else
+            return to_vector<int>(COLUMN);
+    }
+
+    operator std::vector<double>() const
+    {
+        if(data_.size() == 1)
+            return to_vector<double>(ROW);
+        else
+            return to_vector<double>(COLUMN);
+    }
+
+    operator std::vector<std::string>() const
+    {
+        if(data_.size() == 1)
+            return to_vector<std::string>(ROW);
+        else
+            return to_vector<std::string>(COLUMN);
+    }
+
+    operator std::vector<std::vector<int>>() const
+    {
+        return to_matrix<int>();
+    }
+
+    operator std::vector<std::vector<double>>() const
+    {
+        return to_matrix<double>();
+    }
+
+    operator std::vector<std::vector<std::string>>() const
+    {
+        return to_matrix<std::string>();
+    }
+
+private:
+    std::vector<std::string>  header_;
+    std::vector<std::vector<std::string>> data_;
+
+    static std::string concat(const std::vector<std::string>& origin, const std::string& separator)
+    {
+        std::string result;
+        for (const auto& str : origin)
+            result += str + separator;
+        
+        auto separator_size = separator.size();
+        while(separator_size--)
+            result.pop_back();
+        return result;
+    }
+
+    static std::vector<std::string> split(const std::string& origin, const std::string& separator, const bool& auto_trim=false)
+    {
+        if (origin.empty())
+            return {};
+        if (separator.empty())
+            return {origin};
+        
+        std::vector<std::string> result;
+        std::size_t separator_size = separator.size();
+        std::size_t find_start = 0;
+
+        while (true)
+        {
+            std::size_t find_position = origin.find(separator, find_start);
+            if (find_position == std::string::npos)
+            {
+                auto elem = std::string(origin.begin() + find_start, origin.end());
+                if(auto_trim)
+                    result.emplace_back(trim(elem));
+                else
+                    result.emplace_back(elem);
+                break;
+            }
+            auto elem = std::string(origin.begin() + find_start, origin.begin() + find_position);
+            if(auto_trim)
+                result.emplace_back(trim(elem));
+            else
+                result.emplace_back(elem);
+            find_start = find_position + separator_size;
+        }
+        return result;
+    }
+
+    static std::string trim(const std::string& origin)
+    {
+        std::string result = origin;
+        const char *whitespaces = " \t\n\r\f\v";
+        auto last_current_pos = result.find_last_not_of(whitespaces);
+        if (last_current_pos == std::string::npos)
+        {
+            result.clear();
+            return result;
+        }
+        result.erase(last_current_pos + 1);
+        result.erase(0, result.find_first_not_of(whitespaces));
+        return result;
+    }
+
+    /**
+     * @class KeyIndex
+     * @brief 複数列からなるキーに初出順の連番IDを割り当てるハッシュテーブル
+     * @note オープンアドレス法(線形探索)で実装し、スロットにはIDのみを格納する。
+     * @n    キーの実体は登録元の行を参照して比較し、ハッシュ値が一致した場合のみ文字列比較を行う。
+     */
+    class KeyIndex
+    {
+    public:
+        enum : std::size_t { npos = static_cast<std::size_t>(-1) };
+
+        KeyIndex(const std::vector<std::vector<std::string>>& data, const std::vector<std::size_t>& columns, const std::size_t& expected=0)
+        : data_(&data), columns_(columns), slots_(), mask_()
+        {
+            std::size_t capacity = 16;
+            while(capacity < expected * 2)
+                capacity <<= 1;
+            slots_.assign(capacity, 0);
+            mask_ = capacity - 1;
+        }
+
+        /**
+         * @fn insert
+         * @brief 登録元の行のキーを登録し、そのIDを返す (登録済みであれば既存のIDを返す)
+         */
+        std::size_t insert(const std::size_t& row, const std::uint64_t& hash)
+        {
+            const auto& target = (*data_)[row];
+            std::size_t slot = hash & mask_;
+            while(slots_[slot])
+            {
+                const std::size_t id = slots_[slot] - 1;
+                if(hashes_[id] == hash && equal(id, target, columns_))
+                    return id;
+                slot = (slot + 1) & mask_;
+            }
+
+            const std::size_t id = rows_.size();
+            slots_[slot] = id + 1;
+            rows_.push_back(row);
+            hashes_.push_back(hash);
+            if(rows_.size() * 2 > slots_.size())
+                rehash();
+            return id;
+        }
+
+        /**
+         * @fn find
+         * @brief 任意の行のキーに対応するIDを返す (未登録であれば npos を返す)
+         */
+        std::size_t find(const std::vector<std::string>& row, const std::vector<std::size_t>& columns, const std::uint64_t& hash) const
+        {
+            std::size_t slot = hash & mask_;
+            while(slots_[slot])
+            {
+                const std::size_t id = slots_[slot] - 1;
+                if(hashes_[id] == hash && equal(id, row, columns))
+                    return id;
+                slot = (slot + 1) & mask_;
+            }
+            return npos;
+        }
+
+        std::size_t size() const
+        {
+            return rows_.size();
+        }
+
+        std::uint64_t hash(const std::size_t& id) const
+        {
+            return hashes_[id];
+        }
+
+        /**
+         * @fn rows
+         * @brief IDごとの登録元の行インデックスを返す
+         */
+        const std::vector<std::size_t>& rows() const
+        {
+            return rows_;
+        }
+
+    private:
+        const std::vector<std::vector<std::string>>* data_;
+        std::vector<std::size_t> columns_;
+        std::vector<std::size_t> slots_;
+        std::vector<std::size_t> rows_;
+        std::vector<std::uint64_t> hashes_;
+        std::size_t mask_;
+
+        bool equal(const std::size_t& id, const std::vector<std::string>& row, const std::vector<std::size_t>& columns) const
+        {
+            const auto& origin = (*data_)[rows_[id]];
+            for(std::size_t k = 0; k < columns_.size(); k++)
+                if(origin[columns_[k]] != row[columns[k]])
+                    return false;
+            return true;
+        }
+
+        void rehash()
+        {
+            slots_.assign(slots_.size() * 2, 0);
+            mask_ = slots_.size() - 1;
+            for(std::size_t id = 0; id < rows_.size(); id++)
+            {
+                std::size_t slot = hashes_[id] & mask_;
+                while(slots_[slot])
+                    slot = (slot + 1) & mask_;
+                slots_[slot] = id + 1;
+            }
+        }
+    };
+
+    /**
+     * @struct Accumulator
+     * @brief グループ集計の途中値
+     * @note 合計はNeumaierの補正付き加算で求める。first/last は対象要素の行インデックスを保持する。
+     */
+    struct Accumulator
+    {
+        double sum;
+        double compensation;
+        double min;
+        double max;
+        std::size_t count;
+        std::size_t numeric;
+        std::size_t first;
+        std::size_t last;
+    };
+
+    static Accumulator empty_accumulator()
+    {
+        return {0.0, 0.0, std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(), 0, 0, KeyIndex::npos, 0};
+    }
+
+    static void add_compensated(double& sum, double& compensation, const double& value)
+    {
+        const double t = sum + value;
+        if(std::fabs(sum) >= std::fabs(value))
+            compensation += (sum - t) + value;
+        else
+            compensation += (value - t) + sum;
+        sum = t;
+    }
+
+    static void accumulate(Accumulator& acc, const std::string& cell, const std::size_t& row, const bool& numeric)
+    {
+        if(cell.empty())
+            return;
+        acc.count++;
+        acc.first = (std::min)(acc.first, row);
+        acc.last  = (std::max)(acc.last, row);
+
+        double value;
+        if(!numeric || !to_number(cell, value))
+            return;
+        acc.numeric++;
+        add_compensated(acc.sum, acc.compensation, value);
+        acc.min = (std::min)(acc.min, value);
+        acc.max = (std::max)(acc.max, value);
+    }
+
+    static void merge_accumulator(Accumulator& acc, const Accumulator& other)
+    {
+        add_compensated(acc.sum, acc.compensation, other.sum);
+        acc.compensation += other.compensation;
+        acc.min      = (std::min)(acc.min, other.min);
+        acc.max      = (std::max)(acc.max, other.max);
+        acc.count   += other.count;
+        acc.numeric += other.numeric;
+        acc.first    = (std::min)(acc.first, other.first);
+        acc.last     = (std::max)(acc.last, other.last);
+    }
+
+    static std::string aggregation_name(const enum Aggregation& aggregation)
+    {
+        const char* names[] = {"sum", "mean", "count", "min", "max", "first", "last"};
+        return names[aggregation];
+    }
+
+    std::string format_accumulator(const Accumulator& acc, const std::size_t& column, const enum Aggregation& aggregation) const
+    {
+        switch(aggregation)
+        {
+        case SUM:
+            return acc.numeric ? format_number(acc.sum + acc.compensation) : std::string();
+        case MEAN:
+            return acc.numeric ? format_number((acc.sum + acc.compensation) / acc.numeric) : std::string();
+        case COUNT:
+            return std::to_string(acc.count);
+        case MIN:
+            return acc.numeric ? format_number(acc.min) : std::string();
+        case MAX:
+            return acc.numeric ? format_number(acc.max) : std::string();
+        case FIRST:
+            return acc.count ? data_[acc.first][column] : std::string();
+        default: // LAST
+            return acc.count ? data_[acc.last][column] : std::string();
+        }
+    }
+
+    /**
+     * @fn group_aggregate
+     * @brief @ref GroupBy::agg の実装
+     * @note 各グループの集計途中値はグループID順に連続した領域に保持する。
+     */
+    DataFrame group_aggregate(const std::vector<std::size_t>& keys, const std::vector<std::pair<std::string, enum Aggregation>>& spec) const
+    {
+        std::vector<std::size_t> columns;
+        std::vector<bool> numeric;
+        for(const auto& s : spec)
+        {
+            columns.push_back(index_of(s.first));
+            numeric.push_back(s.second == SUM || s.second == MEAN || s.second == MIN || s.second == MAX);
+        }
+
+        const std::size_t width = spec.size();
+        std::vector<std::int64_t> codes;
+        const auto rows = factorize_rows(keys, codes);
+        std::vector<Accumulator> accumulators(rows.size() * width, empty_accumulator());
+        for(std::size_t r = 0; r < data_.size(); r++)
+        {
+            if(codes[r] < 0)
+                continue;
+            const std::size_t id = static_cast<std::size_t>(codes[r]);
+            for(std::size_t k = 0; k < width; k++)
+                accumulate(accumulators[id * width + k], data_[r][columns[k]], r, numeric[k]);
+        }
+
+        return group_frame(keys, spec, columns, rows, accumulators);
+    }
+
+    QuantileSketch quantile_sketch(const std::size_t& column, const enum Execution& execution) const
+    {
+        const std::size_t threads = thread_size(execution, data_.size());
+        std::vector<QuantileSketch> partial(std::max<std::size_t>(threads, 1));
+        const std::size_t chunk = (data_.size() + partial.size() - 1) / partial.size();
+        parallel_for(partial.size(), partial.size(), [&](const std::size_t& begin, const std::size_t& end)
+        {
+            double value;
+            for(auto t = begin; t < end; t++)
+                for(auto r = t * chunk; r < (std::min)(data_.size(), (t + 1) * chunk); r++)
+                    if(to_number(data_[r][column], value))
+                        partial[t].update(value);
+        });
+        for(std::size_t t = 1; t < partial.size(); t++)
+            partial[0].merge(partial[t]);
+        return partial[0];
+    }
+
+    /**
+     * @fn factorize_rows
+     * @brief 指定列の値の組に初出順の整数コードを割り当てる
+     * @note グループ集計・値の集計・重複除去で共通に用いる。
+     * 
+     * @param std::vector<std::size_t> columns 対象の列番号
+     * @param std::vector<std::int64_t> codes 各行のコードの格納先 (skip_missing の場合、空文字を含む行は -1)
+     * @param bool skip_missing 空文字を含む行を除外する
+     * @return std::vector<std::size_t> 各コードの初出行
+     */
+    std::vector<std::size_t> factorize_rows(const std::vector<std::size_t>& columns, std::vector<std::int64_t>& codes, const bool& skip_missing=true) const
+    {
+        const auto hashes = row_hashes(columns, AUTO);
+        KeyIndex index(data_, columns);
+        codes.assign(data_.size(), -1);
+        for(std::size_t r = 0; r < data_.size(); r++)
+        {
+            if(skip_missing && has_missing(data_[r], columns))
+                continue;
+            codes[r] = static_cast<std::int64_t>(index.insert(r, hashes[r]));
+        }
+        return index.rows();
+    }
+
+    /**
+     * @fn row_hashes
+     * @brief 全行の @ref row_hash を列単位でまとめて求める
+     * @note 列ごとに全行を走査して結合するため、1行ずつ求めるよりも同じ列の要素へのアクセスがまとまる。
+     */
+    std::vector<std::uint64_t> row_hashes(const std::vector<std::size_t>& columns, const enum Execution& execution) const
+    {
+        std::vector<std::uint64_t> hashes(data_.size(), 0);
+        parallel_for(data_.size(), thread_size(execution, data_.size() * std::max<std::size_t>(columns.size(), 1)), [&](const std::size_t& begin, const std::size_t& end)
+        {
+            for(const auto& c : columns)
+                for(auto r = begin; r < end; r++)
+                    hashes[r] = hash_combine(hashes[r], hash_string(data_[r][c]));
+            for(auto r = begin; r < end; r++)
+                hashes[r] = mix(hashes[r]);
+        });
+        return hashes;
+    }
+
+    std::vector<std::size_t> all_columns() const
+    {
+        std::vector<std::size_t> columns(header_.size());
+        for(std::size_t c = 0; c < columns.size(); c++)
+            columns[c] = c;
+        return columns;
+    }
+
+    /**
+     * @fn heavy_hitters
+     * @brief 指定列の値の組 (@ref encode_row で1つの文字列にしたもの) を追加した @ref HeavyHitters を作成する
+     */
+    HeavyHitters heavy_hitters(const std::vector<std::size_t>& columns, const std::size_t& capacity, const enum Execution& execution) const
+    {
+        const std::size_t threads = thread_size(execution, data_.size());
+        std::vector<HeavyHitters> partial(std::max<std::size_t>(threads, 1), HeavyHitters(capacity));
+        const std::size_t chunk = (data_.size() + partial.size() - 1) / partial.size();
+        parallel_for(partial.size(), partial.size(), [&](const std::size_t& begin, const std::size_t& end)
+        {
+            for(auto t = begin; t < end; t++)
+                for(auto r = t * chunk; r < (std::min)(data_.size(), (t + 1) * chunk); r++)
+                    if(!has_missing(data_[r], columns))
+                        partial[t].update(encode_row(data_[r], columns));
+        });
+        for(std::size_t t = 1; t < partial.size(); t++)
+            partial[0].merge(partial[t]);
+        return partial[0];
+    }
+
+    /**
+     * @fn encode_row
+     * @brief 指定列の値を区切り文字 (0x1f) で連結した文字列にする (1列の場合は値そのもの)
+     */
+    static std::string encode_row(const std::vector<std::string>& row, const std::vector<std::size_t>& columns)
+    {
+        std::string key = row[columns.front()];
+        for(std::size_t k = 1; k < columns.size(); k++)
+            key.append(1, '\x1f').append(row[columns[k]]);
+        return key;
+    }
+
+    static std::vector<std::string> decode_row(const std::string& key, const std::size_t& width)
+    {
+        std::vector<std::string> row;
+        std::size_t start = 0;
+        for(std::size_t k = 0; k + 1 < width; k++)
+        {
+            const std::size_t end = key.find('\x1f', start);
+            row.push_back(key.substr(start, end - start));
+            start = end + 1;
+        }
+        row.push_back(key.substr(start));
+        return row;
+    }
+
+    DistinctSketch distinct_sketch(const std::size_t& column, const enum Execution& execution) const
+    {
+        const std::size_t threads = thread_size(execution, data_.size());
+        std::vector<DistinctSketch> partial(std::max<std::size_t>(threads, 1));
+        const std::size_t chunk = (data_.size() + partial.size() - 1) / partial.size();
+        parallel_for(partial.size(), partial.size(), [&](const std::size_t& begin, const std::size_t& end)
+        {
+            for(auto t = begin; t < end; t++)
+                for(auto r = t * chunk; r < (std::min)(data_.size(), (t + 1) * chunk); r++)
+                    partial[t].update(data_[r][column]);
+        });
+        for(std::size_t t = 1; t < partial.size(); t++)
+            partial[0].merge(partial[t]);
+        return partial[0];
+    }
+
+    /**
+     * @fn group_nunique
+     * @brief @ref GroupBy::nunique の実装
+     * @note 厳密値はキー列と対象列の組を登録し、新たに登録された組の数をグループごとに数える。(組のハッシュ値はグループのコードから求める)
+     */
+    DataFrame group_nunique(const std::vector<std::size_t>& keys, const std::vector<std::size_t>& columns, const bool& approximate) const
+    {
+        const std::size_t width = columns.size();
+        std::vector<std::int64_t> codes;
+        const auto rows = factorize_rows(keys, codes);
+        std::vector<KeyIndex> pairs;
+        for(const auto& c : columns)
+        {
+            auto pair_columns = keys;
+            pair_columns.push_back(c);
+            pairs.push_back(KeyIndex(data_, pair_columns));
+        }
+        std::vector<std::size_t> counts(approximate ? 0 : rows.size() * width, 0);
+        std::vector<DistinctSketch> sketches(approximate ? rows.size() * width : 0);
+        for(std::size_t r = 0; r < data_.size(); r++)
+        {
+            if(codes[r] < 0)
+                continue;
+            const std::size_t id = static_cast<std::size_t>(codes[r]);
+            for(std::size_t k = 0; k < width; k++)
+            {
+                const auto& cell = data_[r][columns[k]];
+                if(cell.empty())
+                    continue;
+                if(approximate)
+                {
+                    sketches[id * width + k].update(cell);
+                    continue;
+                }
+                const std::size_t before = pairs[k].size();
+                pairs[k].insert(r, mix(hash_combine(id, hash_string(cell))));
+                counts[id * width + k] += pairs[k].size() - before;
+            }
+        }
+
+        std::vector<std::string> header;
+        for(const auto& k : keys)
+            header.push_back(header_[k]);
+        for(const auto& c : columns)
+            header.push_back(header_[c]);
+
+        std::vector<std::vector<std::string>> data;
+        data.reserve(rows.size());
+        for(std::size_t id = 0; id < rows.size(); id++)
+        {
+            std::vector<std::string> row;
+            row.reserve(header.size());
+            for(const auto& k : keys)
+                row.push_back(data_[rows[id]][k]);
+            for(std::size_t k = 0; k < width; k++)
+            {
+                const std::size_t slot = id * width + k;
+                if(approximate)
+                    row.push_back(std::to_string(static_cast<std::uint64_t>(std::llround(sketches[slot].estimate()))));
+                else
+                    row.push_back(std::to_string(counts[slot]));
+            }
+            data.push_back(std::move(row));
+        }
+        return DataFrame(std::move(header), std::move(data));
+    }
+
+    /**
+     * @fn group_quantile
+     * @brief @ref GroupBy::quantile の実装
+     */
+    DataFrame group_quantile(const std::vector<std::size_t>& keys, const std::vector<std::size_t>& columns, const double& q, const bool& approximate) const
+    {
+        if(!(q >= 0.0 && q <= 1.0))
+            throw std::out_of_range("q must be in [0, 1].");
+
+        const std::size_t width = columns.size();
+        std::vector<std::int64_t> codes;
+        const auto rows = factorize_rows(keys, codes);
+        std::vector<std::vector<double>> values(approximate ? 0 : rows.size() * width);
+        std::vector<QuantileSketch> sketches(approximate ? rows.size() * width : 0);
+        for(std::size_t r = 0; r < data_.size(); r++)
+        {
+            if(codes[r] < 0)
+                continue;
+            const std::size_t id = static_cast<std::size_t>(codes[r]);
+            double value;
+            for(std::size_t k = 0; k < width; k++)
+            {
+                if(!to_number(data_[r][columns[k]], value))
+                    continue;
+                if(approximate)
+                    sketches[id * width + k].update(value);
+                else
+                    values[id * width + k].push_back(value);
+            }
+        }
+
+        std::vector<std::string> header;
+        for(const auto& k : keys)
+            header.push_back(header_[k]);
+        for(const auto& c : columns)
+            header.push_back(header_[c]);
+
+        std::vector<std::vector<std::string>> data;
+        data.reserve(rows.size());
+        for(std::size_t id = 0; id < rows.size(); id++)
+        {
+            std::vector<std::string> row;
+            row.reserve(header.size());
+            for(const auto& k : keys)
+                row.push_back(data_[rows[id]][k]);
+            for(std::size_t k = 0; k < width; k++)
+            {
+                const std::size_t slot = id * width + k;
+                if(approximate && sketches[slot].count())
+                    row.push_back(format_number(sketches[slot].quantile(q)));
+                else if(!approximate && !values[slot].empty())
+                    row.push_back(format_number(quantiles(values[slot], {q}).front()));
+                else
+                    row.push_back(std::string());
+            }
+            data.push_back(std::move(row));
+        }
+        return DataFrame(std::move(header), std::move(data));
+    }
+
+    /**
+     * @fn partitioned_group_aggregate
+     * @brief @ref GroupBy::agg の並列実装
+     * @note 1. 行を分割し、各スレッドが自身の担当行をスレッド専用のハッシュテーブルで事前集計する。
+     * @n    2. 事前集計したグループをキーのハッシュ値の上位ビットでパーティションに振り分ける。
+     * @n    3. パーティションごとに各スレッドの結果を統合する。同じキーは必ず同じパーティションに入るためロックは不要。
+     * @n    最後にグループを初出行の順に並べ直し、逐次実行と同じ結果を返す。
+     */
+    DataFrame partitioned_group_aggregate(const std::vector<std::size_t>& keys, const std::vector<std::pair<std::string, enum Aggregation>>& spec, const std::size_t& thread_size) const
+    {
+        std::vector<std::size_t> columns;
+        std::vector<bool> numeric;
+        for(const auto& s : spec)
+        {
+            columns.push_back(index_of(s.first));
+            numeric.push_back(s.second == SUM || s.second == MEAN || s.second == MIN || s.second == MAX);
+        }
+
+        std::size_t partition_bits = 0;
+        while((std::size_t(1) << partition_bits) < thread_size * 4)
+            partition_bits++;
+        const std::size_t partition_size = std::size_t(1) << partition_bits;
+        const std::size_t width = spec.size();
+        const std::size_t chunk = (data_.size() + thread_size - 1) / thread_size;
+
+        // 1. morsel-wise pre-aggregation and 2. radix partitioning of partial groups
+        std::vector<KeyIndex> local_index(thread_size, KeyIndex(data_, keys));
+        std::vector<std::vector<Accumulator>> local_accumulators(thread_size);
+        std::vector<std::vector<std::vector<std::size_t>>> local_partitions(thread_size, std::vector<std::vector<std::size_t>>(partition_size));
+        parallel_for(thread_size, thread_size, [&](const std::size_t& begin, const std::size_t& end)
+        {
+            for(auto t = begin; t < end; t++)
+            {
+                auto& index        = local_index[t];
+                auto& accumulators = local_accumulators[t];
+                const std::size_t last = (std::min)(data_.size(), (t + 1) * chunk);
+                for(auto r = t * chunk; r < last; r++)
+                {
+                    if(has_missing(data_[r], keys))
+                        continue;
+                    const std::size_t id = index.insert(r, row_hash(data_[r], keys));
+                    if(id * width == accumulators.size())
+                        accumulators.resize(accumulators.size() + width, empty_accumulator());
+                    for(std::size_t k = 0; k < width; k++)
+                        accumulate(accumulators[id * width + k], data_[r][columns[k]], r, numeric[k]);
+                }
+                for(std::size_t id = 0; id < index.size(); id++)
+                    local_partitions[t][partition_bits ? index.hash(id) >> (64 - partition_bits) : 0].push_back(id);
+            }
+        });
+
+        // 3. independent merge of each partition
+        std::vector<std::vector<std::size_t>> partition_rows(partition_size);
+        std::vector<std::vector<Accumulator>> partition_accumulators(partition_size);
+        parallel_for(partition_size, thread_size, [&](const std::size_t& begin, const std::size_t& end)
+        {
+            for(auto p = begin; p < end; p++)
+            {
+                KeyIndex index(data_, keys);
+                auto& accumulators = partition_accumulators[p];
+                for(std::size_t t = 0; t < thread_size; t++)
+                {
+                    for(const auto& local_id : local_partitions[t][p])
+                    {
+                        const std::size_t id = index.insert(local_index[t].rows()[local_id], local_index[t].hash(local_id));
+                        if(id * width == accumulators.size())
+                            accumulators.resize(accumulators.size() + width, empty_accumulator());
+                        for(std::size_t k = 0; k < width; k++)
+                            merge_accumulator(accumulators[id * width + k], local_accumulators[t][local_id * width + k]);
+                    }
+                }
+                partition_rows[p] = index.rows();
+            }
+        });
+
+        std::vector<std::pair<std::size_t, std::pair<std::size_t, std::size_t>>> order;
+        for(std::size_t p = 0; p < partition_size; p++)
+            for(std::size_t id = 0; id < partition_rows[p].size(); id++)
+                order.push_back(std::make_pair(partition_rows[p][id], std::make_pair(p, id)));
+        std::sort(order.begin(), order.end());
+
+        std::vector<std::size_t> rows;
+        std::vector<Accumulator> accumulators;
+        rows.reserve(order.size());
+        accumulators.reserve(order.size() * width);
+        for(const auto& o : order)
+        {
+            rows.push_back(o.first);
+            const auto& source = partition_accumulators[o.second.first];
+            accumulators.insert(accumulators.end(), source.begin() + o.second.second * width, source.begin() + (o.second.second + 1) * width);
+        }
+        return group_frame(keys, spec, columns, rows, accumulators);
+    }
+
+    DataFrame group_frame(const std::vector<std::size_t>& keys, const std::vector<std::pair<std::string, enum Aggregation>>& spec, 
+                          const std::vector<std::size_t>& columns, const std::vector<std::size_t>& rows, const std::vector<Accumulator>& accumulators) const
+    {
+        std::vector<std::string> header;
+        for(const auto& key : keys)
+            header.push_back(header_[key]);
+        for(const auto& s : spec)
+        {
+            const auto n = std::count_if(spec.begin(), spec.end(), [&s](const std::pair<std::string, enum Aggregation>& other) { return other.first == s.first; });
+            header.push_back(n > 1 ? s.first + "_" + aggregation_name(s.second) : s.first);
+        }
+
+        const std::size_t width = spec.size();
+        std::vector<std::vector<std::string>> data;
+        data.reserve(rows.size());
+        for(std::size_t id = 0; id < rows.size(); id++)
+        {
+            std::vector<std::string> row;
+            row.reserve(header.size());
+            for(const auto& key : keys)
+                row.push_back(data_[rows[id]][key]);
+            for(std::size_t k = 0; k < width; k++)
+                row.push_back(format_accumulator(accumulators[id * width + k], columns[k], spec[k].second));
+            data.push_back(std::move(row));
+        }
+        return DataFrame(std::move(header), std::move(data));
+    }
+
+    typedef std::vector<std::pair<std::size_t, std::size_t>> RowPairs;
+
+    /**
+     * @fn hash_join
+     * @brief ハッシュ結合により結合する行インデックスの組 (自身の行, 相手の行) を求める
+     * @note 相手の行がない場合は KeyIndex::npos を格納する。
+     */
+    RowPairs hash_join(const DataFrame& other, const std::vector<std::size_t>& left_keys, const std::vector<std::size_t>& right_keys, const enum Join& how) const
+    {
+        const std::size_t npos = KeyIndex::npos;
+        const bool build_left = data_.size() < other.data_.size();
+        const auto& build       = build_left ? data_ : other.data_;
+        const auto& probe       = build_left ? other.data_ : data_;
+        const auto& build_keys  = build_left ? left_keys : right_keys;
+        const auto& probe_keys  = build_left ? right_keys : left_keys;
+
+        // build : key -> chain of rows in row order
+        KeyIndex index(build, build_keys, build.size());
+        std::vector<std::size_t> head, tail, next(build.size(), npos);
+        for(std::size_t r = 0; r < build.size(); r++)
+        {
+            const std::size_t id = index.insert(r, row_hash(build[r], build_keys));
+            if(id == head.size())
+            {
+                head.push_back(r);
+                tail.push_back(r);
+            }
+            else
+            {
+                next[tail[id]] = r;
+                tail[id] = r;
+            }
+        }
+
+        // probe : hash all rows first, then look them up
+        std::vector<std::uint64_t> hashes(probe.size());
+        for(std::size_t r = 0; r < probe.size(); r++)
+            hashes[r] = row_hash(probe[r], probe_keys);
+
+        const bool filter_only  = how == SEMI || how == ANTI;
+        const bool keep_build   = build_left ? (how == LEFT || how == OUTER) : (how == RIGHT || how == OUTER);
+        const bool keep_probe   = build_left ? (how == RIGHT || how == OUTER) : (how == LEFT || how == OUTER);
+        std::vector<bool> build_matched(build.size(), false);
+        RowPairs pairs;
+        for(std::size_t r = 0; r < probe.size(); r++)
+        {
+            const std::size_t id = index.find(probe[r], probe_keys, hashes[r]);
+            if(filter_only)
+            {
+                if(build_left && id != npos)
+                    for(auto b = head[id]; b != npos; b = next[b])
+                        build_matched[b] = true;
+                else if(!build_left && (id != npos) == (how == SEMI))
+                    pairs.push_back(std::make_pair(r, npos));
+                continue;
+            }
+            if(id == npos)
+            {
+                if(keep_probe)
+                    pairs.push_back(build_left ? std::make_pair(npos, r) : std::make_pair(r, npos));
+                continue;
+            }
+            for(auto b = head[id]; b != npos; b = next[b])
+            {
+                build_matched[b] = true;
+                pairs.push_back(build_left ? std::make_pair(b, r) : std::make_pair(r, b));
+            }
+        }
+
+        // unmatched rows of build side
+        if(filter_only && build_left)
+        {
+            for(std::size_t l = 0; l < data_.size(); l++)
+                if(build_matched[l] == (how == SEMI))
+                    pairs.push_back(std::make_pair(l, npos));
+            return pairs;
+        }
+        if(keep_build)
+            for(std::size_t b = 0; b < build.size(); b++)
+                if(!build_matched[b])
+                    pairs.push_back(build_left ? std::make_pair(b, npos) : std::make_pair(npos, b));
+
+        // restore the row order of the driving side (left, or right for RIGHT join)
+        if(!filter_only && build_left == (how != RIGHT))
+        {
+            if(how == RIGHT)
+                std::stable_sort(pairs.begin(), pairs.end(), [](const std::pair<std::size_t, std::size_t>& a, const std::pair<std::size_t, std::size_t>& b) { return a.second < b.second; });
+            else
+                std::stable_sort(pairs.begin(), pairs.end(), [](const std::pair<std::size_t, std::size_t>& a, const std::pair<std::size_t, std::size_t>& b) { return a.first < b.first; });
+        }
+        return pairs;
+    }
+
+    /**
+     * @fn parse_csv
+     * @brief CSV読取処理の本体
+     * @note columns を指定した場合はその列のみを、predicates を指定した場合は全条件を満たす行のみを取り込む。
+     */
+    static DataFrame parse_csv(const std::string& file_path, const bool& header, const std::string& separator, const std::string& new_line, const bool& auto_trim,
+                               const std::shared_ptr<std::vector<std::string>>& columns, const std::vector<LazyFrame::Predicate>& predicates)
+    {
+        std::vector<std::string> header_row;
+        std::vector<std::vector<std::string>> data;
+
+        std::ifstream ifs(file_path, std::ios_base::binary);
+        if(!ifs)
+            throw std::runtime_error("file '" + file_path + "' doesn't exist.");
+
+        std::stringstream ss;
+        ss << ifs.rdbuf();
+        std::string buffer = ss.str();
+        auto line_list = split(buffer, new_line);
+        while(line_list.back().empty())
+            line_list.pop_back();
+
+        // switching header on/off.
+        if(header)
+        {
+            header_row = split(line_list.front(), separator, auto_trim);
+            line_list.erase(line_list.begin());
+        }
+        else
+        {
+            for(auto i=0; i < split(line_list.front(), separator, auto_trim).size();i++) 
+                header_row.push_back(std::to_string(i));
+        }
+
+        // column indices of predicates and projection
+        std::vector<std::size_t> predicate_columns;
+        for(const auto& p : predicates)
+            predicate_columns.push_back(position(header_row, p.column));
+        std::vector<std::size_t> projection;
+        if(columns)
+            for(const auto& column : *columns)
+                projection.push_back(position(header_row, column));
+
+        int row_index = 0;
+        data.reserve(line_list.size());
+        for(auto&& line : line_list)
+        {
+            auto row = split(line, separator, auto_trim);
+            if(row.size() != header_row.size())
+            {
+                std::stringstream ss;
+                ss  << "line[" << row_index + static_cast<int>(header) << "] element size between header and row is different."
+                    << "header's element size : " << header_row.size() << "row's element size : " << row.size();  
+                throw std::runtime_error(ss.str());
+            }
+            row_index++;
+            if(!match(row, predicate_columns, predicates))
+                continue;
+            if(columns)
+                data.push_back(project(row, projection));
+            else
+                data.push_back(row);
+        }
+
+        if(columns)
+            return DataFrame(project(header_row, projection), std::move(data));
+        return DataFrame(std::move(header_row), std::move(data));
+    }
+
+
+    /**
+     * @fn scan
+     * @brief 条件を満たす行の指定列のみを取り出す (columns が nullptr の場合は全列)
      */
-    DataFrame slice(const int& start_index, const int& end_index) const
+    DataFrame scan(const std::shared_ptr<std::vector<std::string>>& columns, const std::vector<LazyFrame::Predicate>& predicates) const
     {
-        const int s_index = (start_index  >= 0) ? start_index  : data_.size() + start_index;
-        const int e_index = (end_index    >= 0) ? end_index    : data_.size() + end_index;
-        if (s_index < 0 || s_index >= data_.size())
-            throw std::out_of_range("start index number was out of range");
-        if (e_index   < 0 || e_index   >= data_.size())
-            throw std::out_of_range("end index number was out of range");
-        if (s_index > e_index)
-            throw std::out_of_range("end index must be larger than start index.");
-        
+        std::vector<std::size_t> predicate_columns;
+        for(const auto& p : predicates)
+            predicate_columns.push_back(index_of(p.column));
+        std::vector<std::size_t> projection;
+        if(columns)
+            projection = indices_of(*columns);
+
         std::vector<std::vector<std::string>> data;
-        for(auto i = s_index; i < e_index; i++)
-            data.push_back(data_[i]);
+        for(const auto& row : data_)
+        {
+            if(!match(row, predicate_columns, predicates))
+                continue;
+            if(columns)
+                data.push_back(project(row, projection));
+            else
+                data.push_back(row);
+        }
+        return DataFrame(columns ? *columns : header_, std::move(data));
+    }
+
+    static bool match(const std::vector<std::string>& row, const std::vector<std::size_t>& columns, const std::vector<LazyFrame::Predicate>& predicates)
+    {
+        for(std::size_t k = 0; k < predicates.size(); k++)
+        {
+            const auto& p = predicates[k];
+            if(p.numeric ? !match(row[columns[k]], p.op, p.number) : !match(row[columns[k]], p.op, p.text))
+                return false;
+        }
+        return true;
+    }
+
+    static std::vector<std::string> project(const std::vector<std::string>& row, const std::vector<std::size_t>& columns)
+    {
+        std::vector<std::string> result;
+        result.reserve(columns.size());
+        for(const auto& c : columns)
+            result.push_back(row[c]);
+        return result;
+    }
+
+    static std::size_t position(const std::vector<std::string>& header, const std::string& column)
+    {
+        auto itr = std::find(header.begin(), header.end(), column);
+        if (itr==header.end())
+            throw std::runtime_error("target column '" + column + "' was not found.");
+        return std::distance(header.begin(), itr);
+    }
+
+    static bool match(const std::string& cell, const enum Compare& op, const double& value)
+    {
+        double number;
+        if(!to_number(cell, number))
+            return op == NOT_EQUAL;
+        switch(op)
+        {
+        case EQUAL:         return number == value;
+        case NOT_EQUAL:     return number != value;
+        case LESS:          return number <  value;
+        case LESS_EQUAL:    return number <= value;
+        case GREATER:       return number >  value;
+        default:            return number >= value; // GREATER_EQUAL
+        }
+    }
+
+    static bool match(const std::string& cell, const enum Compare& op, const std::string& value)
+    {
+        const int order = cell.compare(value);
+        switch(op)
+        {
+        case EQUAL:         return order == 0;
+        case NOT_EQUAL:     return order != 0;
+        case LESS:          return order <  0;
+        case LESS_EQUAL:    return order <= 0;
+        case GREATER:       return order >  0;
+        default:            return order >= 0; // GREATER_EQUAL
+        }
+    }
+
+    /**
+     * @fn select_top
+     * @brief @ref nlargest, @ref nsmallest の実装
+     */
+    DataFrame select_top(const int& n, const std::size_t& column, const std::vector<std::size_t>& by, const bool& largest) const
+    {
+        if(n < 0)
+            throw std::out_of_range("n must not be negative.");
+
+        typedef std::pair<double, std::size_t> Candidate;
+        const auto better = [largest](const Candidate& a, const Candidate& b)
+        {
+            if(a.first != b.first)
+                return largest ? a.first > b.first : a.first < b.first;
+            return a.second < b.second;
+        };
+        const std::size_t limit = n;
+
+        std::vector<std::size_t> rows;
+        double value;
+        if(by.empty())
+        {
+            std::vector<Candidate> candidates;
+            candidates.reserve(data_.size());
+            for(std::size_t r = 0; r < data_.size(); r++)
+                if(to_number(data_[r][column], value))
+                    candidates.push_back(std::make_pair(value, r));
+            const std::size_t size = (std::min)(limit, candidates.size());
+            if(size < candidates.size())
+                std::nth_element(candidates.begin(), candidates.begin() + size, candidates.end(), better);
+            std::sort(candidates.begin(), candidates.begin() + size, better);
+            for(std::size_t i = 0; i < size; i++)
+                rows.push_back(candidates[i].second);
+        }
+        else
+        {
+            // bounded heap per group : the worst kept candidate is on the top
+            KeyIndex index(data_, by);
+            std::vector<std::vector<Candidate>> heaps;
+            for(std::size_t r = 0; r < data_.size() && limit > 0; r++)
+            {
+                if(has_missing(data_[r], by) || !to_number(data_[r][column], value))
+                    continue;
+                const std::size_t id = index.insert(r, row_hash(data_[r], by));
+                if(id == heaps.size())
+                    heaps.push_back(std::vector<Candidate>());
+                auto& heap = heaps[id];
+                const Candidate candidate(value, r);
+                if(heap.size() < limit)
+                {
+                    heap.push_back(candidate);
+                    std::push_heap(heap.begin(), heap.end(), better);
+                }
+                else if(better(candidate, heap.front()))
+                {
+                    std::pop_heap(heap.begin(), heap.end(), better);
+                    heap.back() = candidate;
+                    std::push_heap(heap.begin(), heap.end(), better);
+                }
+            }
+            for(auto& heap : heaps)
+            {
+                std::sort_heap(heap.begin(), heap.end(), better);
+                for(const auto& candidate : heap)
+                    rows.push_back(candidate.second);
+            }
+        }
 
+        std::vector<std::vector<std::string>> data;
+        data.reserve(rows.size());
+        for(const auto& r : rows)
+            data.push_back(data_[r]);
         return DataFrame(header_, std::move(data));
     }
 
     /**
-     * @fn rename
-     * @brief 列名のリネームメソッド
-     * 
-     * @param std::initializer_list<std::stirng> header リネーム後のヘッダー名のリスト 
-     * @return DataFrame& リネーム後の自身のインスタンス
+     * @fn sort_key
+     * @brief 列の要素を大小関係を保つ64bit整数に正規化する
+     * @note 空文字の要素は最大値とし、昇順・降順いずれの場合も末尾に並ぶようにする。
      */
-    DataFrame& rename(const std::initializer_list<std::string>& header)
+    std::vector<std::uint64_t> sort_key(const std::size_t& column, const bool& ascending) const
     {
-        std::vector<std::string> v(header);
-        this->rename(v);
-        return *this;
+        const std::uint64_t missing = (std::numeric_limits<std::uint64_t>::max)();
+        std::vector<std::uint64_t> key(data_.size(), missing);
+
+        bool numeric = true;
+        double value;
+        for(std::size_t r = 0; r < data_.size() && numeric; r++)
+        {
+            if(data_[r][column].empty())
+                continue;
+            if(!to_number(data_[r][column], value))
+            {
+                numeric = false;
+                break;
+            }
+            value += 0.0; // -0.0 -> 0.0
+            std::uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            bits = (bits >> 63) ? ~bits : bits | (std::uint64_t(1) << 63);
+            key[r] = ascending ? bits : ~bits;
+        }
+        if(numeric)
+            return key;
+
+        // rank of each distinct value
+        const std::vector<std::size_t> columns = {column};
+        KeyIndex index(data_, columns);
+        std::vector<std::size_t> ids(data_.size(), KeyIndex::npos);
+        bool mixed = false;
+        for(std::size_t r = 0; r < data_.size(); r++)
+        {
+            if(data_[r][column].empty())
+                continue;
+            ids[r] = index.insert(r, hash_string(data_[r][column]));
+            mixed = mixed || to_number(data_[r][column], value);
+        }
+        std::vector<std::size_t> uniques(index.size());
+        for(std::size_t id = 0; id < uniques.size(); id++)
+            uniques[id] = id;
+        const auto& rows = index.rows();
+        if(mixed)
+            std::sort(uniques.begin(), uniques.end(), [&](const std::size_t& a, const std::size_t& b) { return compare_cell(data_[rows[a]][column], data_[rows[b]][column]) < 0; });
+        else
+            std::sort(uniques.begin(), uniques.end(), [&](const std::size_t& a, const std::size_t& b) { return data_[rows[a]][column] < data_[rows[b]][column]; });
+
+        std::vector<std::uint64_t> rank(uniques.size());
+        for(std::size_t i = 0; i < uniques.size(); i++)
+            rank[uniques[i]] = ascending ? i : uniques.size() - 1 - i;
+        for(std::size_t r = 0; r < data_.size(); r++)
+            if(ids[r] != KeyIndex::npos)
+                key[r] = rank[ids[r]];
+        return key;
+    }
+
+    std::vector<std::vector<std::uint64_t>> sort_keys(const std::vector<std::size_t>& columns, const std::vector<bool>& ascending, const std::size_t& thread_size=1) const
+    {
+        std::vector<std::vector<std::uint64_t>> keys(columns.size());
+        parallel_for(columns.size(), thread_size, [&](const std::size_t& begin, const std::size_t& end)
+        {
+            for(auto k = begin; k < end; k++)
+                keys[k] = sort_key(columns[k], ascending[k]);
+        });
+        return keys;
+    }
+
+    /**
+     * @fn radix_sort
+     * @brief 行インデックスの並びをキーの昇順に安定ソートする (8bitずつのLSD基数ソート)
+     * @note 全要素の桁が同じになるパスは省略する。
+     */
+    static void radix_sort(std::vector<std::size_t>& order, const std::vector<std::uint64_t>& key)
+    {
+        const std::size_t n = order.size();
+        std::vector<std::uint64_t> keys(n), keys_buffer(n);
+        std::vector<std::size_t> order_buffer(n);
+        std::vector<std::size_t> histogram(8 * 256, 0);
+        for(std::size_t i = 0; i < n; i++)
+        {
+            keys[i] = key[order[i]];
+            for(std::size_t b = 0; b < 8; b++)
+                histogram[b * 256 + ((keys[i] >> (8 * b)) & 0xff)]++;
+        }
+
+        for(std::size_t b = 0; b < 8; b++)
+        {
+            std::size_t* count = &histogram[b * 256];
+            if(std::any_of(count, count + 256, [n](const std::size_t& c) { return c == n; }))
+                continue;
+            std::size_t offset = 0;
+            for(std::size_t d = 0; d < 256; d++)
+            {
+                const std::size_t c = count[d];
+                count[d] = offset;
+                offset  += c;
+            }
+            for(std::size_t i = 0; i < n; i++)
+            {
+                const std::size_t position = count[(keys[i] >> (8 * b)) & 0xff]++;
+                keys_buffer[position]  = keys[i];
+                order_buffer[position] = order[i];
+            }
+            keys.swap(keys_buffer);
+            order.swap(order_buffer);
+        }
+    }
+
+    /**
+     * @fn sort_order
+     * @brief 正規化済みの複数キーによる安定な行インデックスの並びを求める
+     * @note 優先度の低いキーから順に安定ソートを重ねる。
+     * @n    複数スレッドの場合は行を分割して各区間を基数ソートし、隣り合う区間を並列マージで統合することを繰り返す。
+     */
+    std::vector<std::size_t> sort_order(const std::vector<std::vector<std::uint64_t>>& keys, const std::size_t& thread_size=1) const
+    {
+        const std::size_t n = data_.size();
+        const std::size_t run_size = std::max<std::size_t>(1, (std::min)(thread_size, n));
+        const std::size_t chunk = n ? (n + run_size - 1) / run_size : 1;
+
+        std::vector<std::size_t> order(n);
+        for(std::size_t r = 0; r < n; r++)
+            order[r] = r;
+
+        std::vector<std::size_t> bounds;
+        for(std::size_t begin = 0; begin < n; begin += chunk)
+            bounds.push_back(begin);
+        bounds.push_back(n);
+
+        parallel_for(bounds.size() - 1, thread_size, [&](const std::size_t& begin, const std::size_t& end)
+        {
+            for(auto b = begin; b < end; b++)
+            {
+                std::vector<std::size_t> run(order.begin() + bounds[b], order.begin() + bounds[b + 1]);
+                for(auto key = keys.rbegin(); key != keys.rend(); key++)
+                    radix_sort(run, *key);
+                std::copy(run.begin(), run.end(), order.begin() + bounds[b]);
+            }
+        });
+
+        const auto less = [&keys](const std::size_t& a, const std::size_t& b)
+        {
+            for(const auto& key : keys)
+                if(key[a] != key[b])
+                    return key[a] < key[b];
+            return false;
+        };
+
+        std::vector<std::size_t> buffer(n);
+        while(bounds.size() > 2)
+        {
+            // (first run, part) tasks : each merge of two runs is split into parts by co-ranking
+            const std::size_t pair_size = (bounds.size() - 1) / 2;
+            const std::size_t part_size = std::max<std::size_t>(1, thread_size / std::max<std::size_t>(1, pair_size));
+            std::vector<std::size_t> next_bounds;
+            for(std::size_t b = 0; b + 1 < bounds.size(); b += 2)
+                next_bounds.push_back(bounds[b]);
+            next_bounds.push_back(n);
+
+            parallel_for((bounds.size() - 1) * part_size, thread_size, [&](const std::size_t& begin, const std::size_t& end)
+            {
+                for(auto task = begin; task < end; task++)
+                {
+                    const std::size_t b    = task / part_size * 2;
+                    const std::size_t part = task % part_size;
+                    if(b + 1 >= bounds.size())
+                        continue;
+                    const auto first = order.begin() + bounds[b];
+                    if(b + 2 >= bounds.size())
+                    {
+                        // odd run : copy as it is
+                        if(part == 0)
+                            std::copy(first, order.begin() + bounds[b + 1], buffer.begin() + bounds[b]);
+                        continue;
+                    }
+                    const auto middle = order.begin() + bounds[b + 1];
+                    const auto last   = order.begin() + bounds[b + 2];
+                    const std::size_t total = bounds[b + 2] - bounds[b];
+                    const std::size_t lower = co_rank(first, middle, last, total * part / part_size, less);
+                    const std::size_t upper = co_rank(first, middle, last, total * (part + 1) / part_size, less);
+                    const std::size_t lower_output = total * part / part_size;
+                    std::merge(first + lower, first + upper, 
+                               middle + (lower_output - lower), middle + (total * (part + 1) / part_size - upper),
+                               buffer.begin() + bounds[b] + lower_output, less);
+                }
+            });
+            order.swap(buffer);
+            bounds.swap(next_bounds);
+        }
+        return order;
+    }
+
+    /**
+     * @fn co_rank
+     * @brief 2つの整列済み区間 [first, middle), [middle, last) を安定にマージした結果の先頭 index 要素のうち、
+     * @n    前半の区間から取られる要素数を二分探索で求める
+     */
+    template<typename Iterator, typename Less>
+    static std::size_t co_rank(const Iterator& first, const Iterator& middle, const Iterator& last, const std::size_t& index, const Less& less)
+    {
+        const std::size_t a_size = middle - first;
+        const std::size_t b_size = last - middle;
+        std::size_t lower = index > b_size ? index - b_size : 0;
+        std::size_t upper = (std::min)(index, a_size);
+        while(true)
+        {
+            const std::size_t a = (lower + upper) / 2;
+            const std::size_t b = index - a;
+            if(a > 0 && b < b_size && less(middle[b], first[a - 1]))
+                upper = a - 1;
+            else if(b > 0 && a < a_size && !less(middle[b - 1], first[a]))
+                lower = a + 1;
+            else
+                return a;
+        }
+    }
+
+    /**
+     * @fn compare_cell
+     * @brief 要素の大小比較 (両方が数値であれば数値として、それ以外は文字列として比較する)
+     * @note 数値は文字列より前に、空文字は末尾に置く。(@ref sort_values の昇順と同じ並び)
+     * @n    数値として等しい場合は文字列として比較し、文字列が一致する場合のみ0を返す。
+     */
+    static int compare_cell(const std::string& a, const std::string& b)
+    {
+        if(a.empty() || b.empty())
+            return a.empty() == b.empty() ? 0 : (a.empty() ? 1 : -1);
+        double x = 0, y = 0;
+        const bool a_number = to_number(a, x);
+        const bool b_number = to_number(b, y);
+        if(a_number && b_number && x != y)
+            return x < y ? -1 : 1;
+        if(a_number != b_number)
+            return a_number ? -1 : 1;
+        return a.compare(b);
+    }
+
+    static int compare_key(const std::vector<std::string>& a, const std::vector<std::size_t>& a_columns, const std::vector<std::string>& b, const std::vector<std::size_t>& b_columns)
+    {
+        for(std::size_t k = 0; k < a_columns.size(); k++)
+        {
+            const int result = compare_cell(a[a_columns[k]], b[b_columns[k]]);
+            if(result != 0)
+                return result;
+        }
+        return 0;
+    }
+
+    bool is_sorted_by(const std::vector<std::size_t>& columns) const
+    {
+        for(std::size_t r = 1; r < data_.size(); r++)
+            if(compare_key(data_[r - 1], columns, data_[r], columns) > 0)
+                return false;
+        return true;
+    }
+
+    /**
+     * @fn is_sorted_with
+     * @brief 自身と相手の両方がキー順に並んでいるかを判定する
+     * @note 両方を同じ位置まで交互に確認するため、一方が並んでいなければ先頭の乱れた位置までの走査で打ち切る。
+     */
+    bool is_sorted_with(const DataFrame& other, const std::vector<std::size_t>& left_keys, const std::vector<std::size_t>& right_keys) const
+    {
+        const std::size_t size = (std::max)(data_.size(), other.data_.size());
+        for(std::size_t r = 1; r < size; r++)
+        {
+            if(r < data_.size() && compare_key(data_[r - 1], left_keys, data_[r], left_keys) > 0)
+                return false;
+            if(r < other.data_.size() && compare_key(other.data_[r - 1], right_keys, other.data_[r], right_keys) > 0)
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * @fn key_order
+     * @brief キー順の行インデックスを返す (キーが等しい行は元の行順)
+     */
+    std::vector<std::size_t> key_order(const std::vector<std::size_t>& columns) const
+    {
+        std::vector<std::size_t> order(data_.size());
+        for(std::size_t r = 0; r < order.size(); r++)
+            order[r] = r;
+        std::stable_sort(order.begin(), order.end(), [&](const std::size_t& a, const std::size_t& b)
+        {
+            return compare_key(data_[a], columns, data_[b], columns) < 0;
+        });
+        return order;
+    }
+
+    /**
+     * @fn sort_merge_join
+     * @brief ソートマージ結合により結合する行インデックスの組 (自身の行, 相手の行) を求める
+     * @note 両方をキー順に1回ずつ走査し、同じキーの相手側の行の範囲 (走査位置の組) のみを保持して組を出力する。
+     * @n    既にキー順に並んでいる側は行をそのまま走査し、並んでいない側のみ行インデックスを並べ替える。
+     * @n    そのため両方がキー順であれば、結果以外に要する領域は同じキーの行の範囲を表す位置のみとなる。
+     */
+    RowPairs sort_merge_join(const DataFrame& other, const std::vector<std::size_t>& left_keys, const std::vector<std::size_t>& right_keys, const enum Join& how,
+                             const bool& left_sorted, const bool& right_sorted) const
+    {
+        const std::size_t npos = KeyIndex::npos;
+        const auto left_order  = left_sorted  ? std::vector<std::size_t>() : key_order(left_keys);
+        const auto right_order = right_sorted ? std::vector<std::size_t>() : other.key_order(right_keys);
+        const auto left_row    = [&](const std::size_t& i) { return left_sorted  ? i : left_order[i]; };
+        const auto right_row   = [&](const std::size_t& j) { return right_sorted ? j : right_order[j]; };
+        const std::size_t left_size  = data_.size();
+        const std::size_t right_size = other.data_.size();
+        const bool keep_left   = how == LEFT  || how == OUTER || how == ANTI;
+        const bool keep_right  = how == RIGHT || how == OUTER;
+
+        RowPairs pairs;
+        std::size_t i = 0, j = 0;
+        while(i < left_size && j < right_size)
+        {
+            const auto& left  = data_[left_row(i)];
+            const auto& right = other.data_[right_row(j)];
+            const int order = compare_key(left, left_keys, right, right_keys);
+            if(order < 0)
+            {
+                if(keep_left)
+                    pairs.push_back(std::make_pair(left_row(i), npos));
+                i++;
+                continue;
+            }
+            if(order > 0)
+            {
+                if(keep_right)
+                    pairs.push_back(std::make_pair(npos, right_row(j)));
+                j++;
+                continue;
+            }
+
+            // run of equal keys on the right : [j, run_end)
+            std::size_t run_end = j + 1;
+            while(run_end < right_size && compare_key(other.data_[right_row(run_end)], right_keys, right, right_keys) == 0)
+                run_end++;
+            for(; i < left_size && compare_key(data_[left_row(i)], left_keys, right, right_keys) == 0; i++)
+            {
+                if(how == SEMI)
+                    pairs.push_back(std::make_pair(left_row(i), npos));
+                else if(how != ANTI)
+                    for(auto k = j; k < run_end; k++)
+                        pairs.push_back(std::make_pair(left_row(i), right_row(k)));
+            }
+            j = run_end;
+        }
+        for(; keep_left && i < left_size; i++)
+            pairs.push_back(std::make_pair(left_row(i), npos));
+        for(; keep_right && j < right_size; j++)
+            pairs.push_back(std::make_pair(npos, right_row(j)));
+
+        if(!left_sorted && (how == SEMI || how == ANTI))
+            std::sort(pairs.begin(), pairs.end());
+        return pairs;
+    }
+
+    /**
+     * @fn rolling_aggregate
+     * @brief @ref Rolling の集計の実装
+     * @note 各行の窓の開始位置を求めた後、列ごとに窓へ入る要素を加え、窓から出る要素を除く差分更新で集計する。
+     */
+    DataFrame rolling_aggregate(const Rolling& rolling, const Rolling::Statistic& statistic, const int& ddof) const
+    {
+        const std::size_t n = data_.size();
+        std::vector<std::size_t> starts(n);
+        std::vector<std::size_t> columns;
+        std::vector<std::string> header;
+        if(rolling.on_.empty())
+        {
+            for(std::size_t r = 0; r < n; r++)
+                starts[r] = r + 1 >= static_cast<std::size_t>(rolling.window_) ? r + 1 - rolling.window_ : 0;
+        }
+        else
+        {
+            const auto time = sorted_times(rolling.on_);
+            std::size_t start = 0;
+            for(std::size_t r = 0; r < n; r++)
+            {
+                while(time[start] <= time[r] - rolling.duration_)
+                    start++;
+                starts[r] = start;
+            }
+            header.push_back(rolling.on_);
+        }
+
+        const std::size_t on = rolling.on_.empty() ? KeyIndex::npos : index_of(rolling.on_);
+        for(std::size_t c = 0; c < header_.size(); c++)
+        {
+            if(c == on || !is_numeric_column(c))
+                continue;
+            columns.push_back(c);
+            header.push_back(header_[c]);
+        }
+
+        std::vector<std::vector<std::string>> results(columns.size());
+        parallel_for(columns.size(), thread_size(AUTO, n * columns.size()), [&](const std::size_t& begin, const std::size_t& end)
+        {
+            for(auto k = begin; k < end; k++)
+                results[k] = rolling_column(columns[k], starts, statistic, ddof, rolling.min_periods_);
+        });
+
+        std::vector<std::vector<std::string>> data(n);
+        for(std::size_t r = 0; r < n; r++)
+        {
+            data[r].reserve(header.size());
+            if(on != KeyIndex::npos)
+                data[r].push_back(data_[r][on]);
+            for(const auto& result : results)
+                data[r].push_back(result[r]);
+        }
+        return DataFrame(std::move(header), std::move(data));
+    }
+
+    std::vector<std::string> rolling_column(const std::size_t& column, const std::vector<std::size_t>& starts, const Rolling::Statistic& statistic, const int& ddof, const int& min_periods) const
+    {
+        const std::size_t n = data_.size();
+        std::vector<double> values(n);
+        for(std::size_t r = 0; r < n; r++)
+            if(!to_number(data_[r][column], values[r]))
+                values[r] = std::numeric_limits<double>::quiet_NaN();
+
+        std::vector<std::string> result(n);
+        std::size_t count = 0, start = 0;
+        double sum = 0.0, compensation = 0.0, mean = 0.0, m2 = 0.0;
+        std::deque<std::size_t> extremes; // monotonic queue of row indices
+        const bool minimum = statistic == Rolling::ROLLING_MIN;
+        for(std::size_t r = 0; r < n; r++)
+        {
+            // remove rows leaving the window
+            for(; start < starts[r]; start++)
+            {
+                const double x = values[start];
+                if(x != x)
+                    continue;
+                count--;
+                add_compensated(sum, compensation, -x);
+                if(count == 0)
+                {
+                    mean = m2 = 0.0;
+                    continue;
+                }
+                const double delta = x - mean;
+                mean -= delta / count;
+                m2   -= delta * (x - mean);
+                m2    = (std::max)(m2, 0.0);
+            }
+            while(!extremes.empty() && extremes.front() < starts[r])
+                extremes.pop_front();
+
+            // add the row entering the window
+            const double x = values[r];
+            if(x == x)
+            {
+                count++;
+                add_compensated(sum, compensation, x);
+                const double delta = x - mean;
+                mean += delta / count;
+                m2   += delta * (x - mean);
+                while(!extremes.empty() && (minimum ? values[extremes.back()] >= x : values[extremes.back()] <= x))
+                    extremes.pop_back();
+                extremes.push_back(r);
+            }
+
+            if(count == 0 || static_cast<int>(count) < min_periods)
+                continue;
+            switch(statistic)
+            {
+            case Rolling::ROLLING_SUM:
+                result[r] = format_number(sum + compensation);
+                break;
+            case Rolling::ROLLING_MEAN:
+                result[r] = format_number((sum + compensation) / count);
+                break;
+            case Rolling::ROLLING_MIN:
+            case Rolling::ROLLING_MAX:
+                result[r] = format_number(values[extremes.front()]);
+                break;
+            case Rolling::ROLLING_VAR:
+                if(static_cast<int>(count) > ddof)
+                    result[r] = format_number(m2 / (count - ddof));
+                break;
+            default: // ROLLING_STD
+                if(static_cast<int>(count) > ddof)
+                    result[r] = format_number(std::sqrt(m2 / (count - ddof)));
+                break;
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @fn ewm_aggregate
+     * @brief @ref Ewm の集計の実装
+     * @note 列ごとに状態を引き継ぎながら1パスで更新する。(pandas の ewmcov のオンライン更新式)
+     */
+    DataFrame ewm_aggregate(const Ewm& ewm, std::map<std::string, Ewm::State>& states, const bool& variance) const
+    {
+        std::vector<std::size_t> columns;
+        std::vector<Ewm::State*> column_states;
+        for(std::size_t c = 0; c < header_.size(); c++)
+        {
+            if(!is_numeric_column(c))
+                continue;
+            columns.push_back(c);
+            auto it = states.find(header_[c]);
+            if(it == states.end())
+            {
+                const Ewm::State empty = {0, 0.0, 0.0, 0.0, 0.0, 0.0};
+                it = states.insert(std::make_pair(header_[c], empty)).first;
+            }
+            column_states.push_back(&it->second);
+        }
+
+        std::vector<std::vector<std::string>> results(columns.size());
+        parallel_for(columns.size(), thread_size(AUTO, data_.size() * columns.size()), [&](const std::size_t& begin, const std::size_t& end)
+        {
+            for(auto k = begin; k < end; k++)
+                results[k] = ewm_column(columns[k], ewm.alpha_, ewm.adjust_, variance, *column_states[k]);
+        });
+
+        std::vector<std::string> header;
+        for(const auto& c : columns)
+            header.push_back(header_[c]);
+        std::vector<std::vector<std::string>> data(data_.size());
+        for(std::size_t r = 0; r < data_.size(); r++)
+        {
+            data[r].reserve(columns.size());
+            for(const auto& result : results)
+                data[r].push_back(result[r]);
+        }
+        return DataFrame(std::move(header), std::move(data));
+    }
+
+    std::vector<std::string> ewm_column(const std::size_t& column, const double& alpha, const bool& adjust, const bool& variance, Ewm::State& state) const
+    {
+        const double old_factor = 1.0 - alpha;
+        const double new_weight = adjust ? 1.0 : alpha;
+        std::vector<std::string> result(data_.size());
+        for(std::size_t r = 0; r < data_.size(); r++)
+        {
+            double x;
+            if(to_number(data_[r][column], x))
+            {
+                if(state.count++ == 0)
+                {
+                    state.mean = x;
+                    state.cov  = 0.0;
+                    state.sum_weight = state.sum_weight2 = state.old_weight = 1.0;
+                }
+                else
+                {
+                    state.old_weight  *= old_factor;
+                    state.sum_weight  *= old_factor;
+                    state.sum_weight2 *= old_factor * old_factor;
+                    const double old_mean = state.mean;
+                    const double total    = state.old_weight + new_weight;
+                    if(state.mean != x)
+                        state.mean = (state.old_weight * old_mean + new_weight * x) / total;
+                    const double delta = old_mean - state.mean;
+                    state.cov = (state.old_weight * (state.cov + delta * delta) + new_weight * (x - state.mean) * (x - state.mean)) / total;
+                    state.sum_weight  += new_weight;
+                    state.sum_weight2 += new_weight * new_weight;
+                    state.old_weight  += new_weight;
+                    if(!adjust)
+                    {
+                        state.sum_weight  /= state.old_weight;
+                        state.sum_weight2 /= state.old_weight * state.old_weight;
+                        state.old_weight   = 1.0;
+                    }
+                }
+            }
+
+            if(state.count == 0)
+                continue;
+            if(!variance)
+            {
+                result[r] = format_number(state.mean);
+                continue;
+            }
+            const double numerator   = state.sum_weight * state.sum_weight;
+            const double denominator = numerator - state.sum_weight2;
+            if(denominator > 0.0)
+                result[r] = format_number(numerator / denominator * state.cov);
+        }
+        return result;
+    }
+
+    /**
+     * @fn cumulative
+     * @brief 累積演算の実装
+     * @note 1パス目で各範囲の要素を変換しつつ範囲ごとの集計値を求め、範囲の前置集計値を初期値として2パス目で出力する。
+     */
+    template<class F>
+    DataFrame cumulative(const enum Execution& execution, const double& identity, const F& op) const
+    {
+        const std::size_t n = data_.size();
+        const std::size_t chunks = thread_size(execution, n);
+        const std::size_t chunk  = chunks > 1 ? (n + chunks - 1) / chunks : n;
+        return numeric_columns([&](const std::size_t& column, std::vector<std::string>& result)
+        {
+            std::vector<double> values(n);
+            std::vector<double> totals(chunks, identity);
+            parallel_for(chunks, chunks, [&](const std::size_t& begin, const std::size_t& end)
+            {
+                for(auto t = begin; t < end; t++)
+                {
+                    for(auto r = t * chunk; r < (std::min)(n, (t + 1) * chunk); r++)
+                    {
+                        if(!to_number(data_[r][column], values[r]))
+                            values[r] = std::numeric_limits<double>::quiet_NaN();
+                        else
+                            totals[t] = op(totals[t], values[r]);
+                    }
+                }
+            });
+
+            // exclusive prefix of the chunk totals
+            double carry = identity;
+            for(auto& total : totals)
+            {
+                const double next = op(carry, total);
+                total = carry;
+                carry = next;
+            }
+
+            parallel_for(chunks, chunks, [&](const std::size_t& begin, const std::size_t& end)
+            {
+                for(auto t = begin; t < end; t++)
+                {
+                    double acc = totals[t];
+                    for(auto r = t * chunk; r < (std::min)(n, (t + 1) * chunk); r++)
+                    {
+                        if(values[r] != values[r])
+                            continue;
+                        acc = op(acc, values[r]);
+                        result[r] = format_number(acc);
+                    }
+                }
+            });
+        });
     }
 
     /**
-     * @fn rename
-     * @brief 列名のリネームメソッド
-     * 
-     * @param std::vector<std::stirng> header リネーム後のヘッダー名のリスト 
-     * @return DataFrame& リネーム後の自身のインスタンス
+     * @fn difference
+     * @brief @ref diff, @ref pct_change の実装
      */
-    DataFrame& rename(const std::vector<std::string> header)
+    template<class F>
+    DataFrame difference(const int& periods, const enum Execution& execution, const F& op) const
     {
-        if(header.size()!=header_.size())
-            throw std::runtime_error("header size is different");
-        header_ = header;
-        return *this;
+        const std::size_t n = data_.size();
+        const std::size_t threads = thread_size(execution, n);
+        return numeric_columns([&](const std::size_t& column, std::vector<std::string>& result)
+        {
+            std::vector<double> values(n);
+            parallel_for(n, threads, [&](const std::size_t& begin, const std::size_t& end)
+            {
+                for(auto r = begin; r < end; r++)
+                    if(!to_number(data_[r][column], values[r]))
+                        values[r] = std::numeric_limits<double>::quiet_NaN();
+            });
+            parallel_for(n, threads, [&](const std::size_t& begin, const std::size_t& end)
+            {
+                for(auto r = begin; r < end; r++)
+                {
+                    const long long other = static_cast<long long>(r) - periods;
+                    if(other < 0 || other >= static_cast<long long>(n))
+                        continue;
+                    const double current  = values[r];
+                    const double previous = values[static_cast<std::size_t>(other)];
+                    double value;
+                    if(current == current && previous == previous && op(current, previous, value))
+                        result[r] = format_number(value);
+                }
+            });
+        });
     }
 
     /**
-     * @fn describe
-     * @brief メタ情報取得表示メソッド
-     */ 
-    void describe() const
+     * @fn numeric_columns
+     * @brief 数値列ごとに func(列番号, 結果の列) を呼び出し、結果の列からなるDataFrameを返す
+     */
+    template<class F>
+    DataFrame numeric_columns(const F& func) const
     {
-        std::cout << "header names: {" << concat(header_, ",") << "}" << std::endl;
-        std::cout << "    row size: " << data_.size() << std::endl;
-        std::cout << " column size: " << header_.size() << std::endl;
+        std::vector<std::string> header;
+        std::vector<std::vector<std::string>> results;
+        for(std::size_t c = 0; c < header_.size(); c++)
+        {
+            if(!is_numeric_column(c))
+                continue;
+            header.push_back(header_[c]);
+            results.push_back(std::vector<std::string>(data_.size()));
+            func(c, results.back());
+        }
+
+        std::vector<std::vector<std::string>> data(data_.size());
+        for(std::size_t r = 0; r < data_.size(); r++)
+        {
+            data[r].reserve(header.size());
+            for(const auto& result : results)
+                data[r].push_back(result[r]);
+        }
+        return DataFrame(std::move(header), std::move(data));
     }
 
     /**
-     * @fn data
-     * @brief データ取り出しメソッド
-     *  
-     * @return std::vector<std::vector<std::string> data 
+     * @fn is_numeric_column
+     * @brief 空文字を除く全要素が数値に変換できる列であるか
      */
-    std::vector<std::vector<std::string>> data() const
+    bool is_numeric_column(const std::size_t& column) const
     {
-        return data_;
+        double value;
+        for(const auto& row : data_)
+            if(!row[column].empty() && !to_number(row[column], value))
+                return false;
+        return true;
     }
 
     /**
-     * @fn to_matrix
-     * @brief 2次元ベクターに変換するメソッド
-     * 
-     * @tparam T 
-     * @return std::vector<T> 
+     * @fn sorted_times
+     * @brief 時刻の列を数値に変換する (数値でない、または昇順でない場合は例外を送出する)
      */
-    template<typename T>
-    std::vector<std::vector<T>> to_matrix() const
+    std::vector<double> sorted_times(const std::string& column) const
     {
-        std::vector<std::vector<T>> result;
-        std::vector<T> tmp;
-        result.reserve(data_.size());
-        for(const auto& line : data_)
+        const std::size_t c = index_of(column);
+        std::vector<double> result(data_.size());
+        for(std::size_t r = 0; r < data_.size(); r++)
         {
-            tmp.clear();
-            tmp.reserve(line.size());
-            for(const auto& e : line)
-            {
-                tmp.push_back(As<T>::as(e));
-            }
-            result.push_back(tmp);
+            if(!to_number(data_[r][c], result[r]))
+                throw std::runtime_error("column '" + column + "' must be numeric. line[" + std::to_string(r) + "] is '" + data_[r][c] + "'.");
+            if(r > 0 && result[r] < result[r - 1])
+                throw std::runtime_error("column '" + column + "' must be sorted in ascending order.");
         }
         return result;
     }
 
     /**
-     * @fn to_vector
-     * @brief 列・行いずれかを指定の型の1次元ベクターに変換するメソッド
-     * 
-     * @tparam T 
-     * @param enum Axis axis ベクター化したい軸 { ROW : 行, COLUMN : 列 } 
-     * @return std::vector<T> 
+     * @fn join_frame
+     * @brief 行インデックスの組から結合後のDataFrameを組み立てる
      */
-    template<typename T>
-    std::vector<T> to_vector(const enum Axis& axis=COLUMN) const
+    DataFrame join_frame(const DataFrame& other, const std::vector<std::size_t>& left_keys, const std::vector<std::size_t>& right_keys, const RowPairs& pairs, const enum Join& how) const
     {
-        if(axis==ROW && data_.size() != 1)
-            throw std::runtime_error("to_vector method can be used to 1 raw DataFrame only.");
-        if(axis==COLUMN && header_.size() != 1)
-            throw std::runtime_error("to_vector method can be used to 1 column DataFrame only.");
-        
-        std::vector<T> result;
-        if(axis==COLUMN)
-            for(const auto& row : data_)
-                result.push_back(As<T>::as(row[0]));
-        else // ROW
-            for(const auto& e : data_[0])
-                result.push_back(As<T>::as(e));
-        return result;
-    } 
+        const std::size_t npos = KeyIndex::npos;
+        if(how == SEMI || how == ANTI)
+        {
+            std::vector<std::vector<std::string>> data;
+            data.reserve(pairs.size());
+            for(const auto& pair : pairs)
+                data.push_back(data_[pair.first]);
+            return DataFrame(header_, std::move(data));
+        }
 
-    /**
-     * @fn as
-     * @brief 1行・1列のDataFrameインスタンスを特定の型に変換する
-     * 
-     * @tparam T 
-     * @return T 取得したい型に変換したデータ返却する
-     */
-    template<typename T>
-    T as() const
-    {
-        if(data_.size() != 1 || data_.at(0).size() != 1)
+        std::vector<std::size_t> right_columns;
+        for(std::size_t c = 0; c < other.header_.size(); c++)
+            if(std::find(right_keys.begin(), right_keys.end(), c) == right_keys.end())
+                right_columns.push_back(c);
+
+        // position of each left key in right key list
+        std::vector<std::size_t> key_source(header_.size(), npos);
+        for(std::size_t k = 0; k < left_keys.size(); k++)
+            key_source[left_keys[k]] = right_keys[k];
+
+        std::vector<std::string> header;
+        for(std::size_t c = 0; c < header_.size(); c++)
         {
-            throw std::runtime_error("as method can be used to 1 raw and 1 column DataFrame only.");
+            const bool duplicated = key_source[c] == npos && std::any_of(right_columns.begin(), right_columns.end(), [&](const std::size_t& rc) { return other.header_[rc] == header_[c]; });
+            header.push_back(duplicated ? header_[c] + "_x" : header_[c]);
+        }
+        for(const auto& rc : right_columns)
+        {
+            const bool duplicated = std::any_of(header_.begin(), header_.end(), [&](const std::string& name) { return name == other.header_[rc]; })
+                                 && std::find(right_keys.begin(), right_keys.end(), rc) == right_keys.end();
+            header.push_back(duplicated ? other.header_[rc] + "_y" : other.header_[rc]);
         }
 
-        return As<T>::as(data_[0][0]);
+        const std::vector<std::string> empty_left(header_.size()), empty_right(other.header_.size());
+        std::vector<std::vector<std::string>> data;
+        data.reserve(pairs.size());
+        for(const auto& pair : pairs)
+        {
+            const auto& left  = pair.first  != npos ? data_[pair.first]        : empty_left;
+            const auto& right = pair.second != npos ? other.data_[pair.second] : empty_right;
+            std::vector<std::string> row;
+            row.reserve(header.size());
+            for(std::size_t c = 0; c < header_.size(); c++)
+                row.push_back(pair.first == npos && key_source[c] != npos ? right[key_source[c]] : left[c]);
+            for(const auto& rc : right_columns)
+                row.push_back(right[rc]);
+            data.push_back(std::move(row));
+        }
+        return DataFrame(std::move(header), std::move(data));
     }
 
-    operator int() const
+    DataFrame assign_column(const std::string& name, std::vector<std::string>&& values) const
     {
-        return as<int>();
+        auto header = header_;
+        auto data   = data_;
+        const auto itr = std::find(header.begin(), header.end(), name);
+        if(itr == header.end())
+        {
+            header.push_back(name);
+            for(std::size_t r = 0; r < data.size(); r++)
+                data[r].push_back(std::move(values[r]));
+        }
+        else
+        {
+            const std::size_t c = std::distance(header.begin(), itr);
+            for(std::size_t r = 0; r < data.size(); r++)
+                data[r][c] = std::move(values[r]);
+        }
+        return DataFrame(std::move(header), std::move(data));
     }
 
-    operator double() const
+    std::size_t index_of(const std::string& column) const
     {
-        return as<double>();
+        auto itr = std::find(header_.begin(), header_.end(), column);
+        if (itr==header_.end())
+            throw std::runtime_error("target column '" + column + "' was not found.");
+        return std::distance(header_.begin(), itr);
     }
 
-    operator std::string() const
+    std::vector<std::size_t> indices_of(const std::vector<std::string>& columns) const
     {
-        return as<std::string>();
+        std::vector<std::size_t> result;
+        for(const auto& column : columns)
+            result.push_back(index_of(column));
+        return result;
     }
 
-    operator std::vector<int>() const
+    static bool has_missing(const std::vector<std::string>& row, const std::vector<std::size_t>& columns)
     {
-        if(data_.size() == 1)
-            return to_vector<int>(ROW);
-        else
-            return to_vector<int>(COLUMN);
+        for(const auto& c : columns)
+            if(row[c].empty())
+                return true;
+        return false;
     }
 
-    operator std::vector<double>() const
+    static std::uint64_t mix(std::uint64_t value)
     {
-        if(data_.size() == 1)
-            return to_vector<double>(ROW);
-        else
-            return to_vector<double>(COLUMN);
+        value ^= value >> 33;
+        value *= 0xff51afd7ed558ccdULL;
+        value ^= value >> 33;
+        value *= 0xc4ceb9fe1a85ec53ULL;
+        value ^= value >> 33;
+        return value;
     }
 
-    operator std::vector<std::string>() const
+    /**
+     * @fn hash_string
+     * @brief 文字列の64bitハッシュ値 (非暗号学的ハッシュ)
+     * @note 8バイト単位で読み取って乗算・シフトで撹拌する。
+     */
+    static std::uint64_t hash_string(const std::string& value)
     {
-        if(data_.size() == 1)
-            return to_vector<std::string>(ROW);
-        else
-            return to_vector<std::string>(COLUMN);
+        const std::uint64_t k = 0x9e3779b97f4a7c15ULL;
+        const char* p = value.data();
+        std::size_t n = value.size();
+        std::uint64_t h = n * k;
+        std::uint64_t word;
+        for(; n >= 8; n -= 8, p += 8)
+        {
+            std::memcpy(&word, p, 8);
+            h = (h ^ mix(word)) * k;
+        }
+        if(n)
+        {
+            word = 0;
+            std::memcpy(&word, p, n);
+            h = (h ^ mix(word)) * k;
+        }
+        return mix(h);
     }
 
-    operator std::vector<std::vector<int>>() const
+    static std::uint64_t hash_combine(const std::uint64_t& seed, const std::uint64_t& value)
     {
-        return to_matrix<int>();
+        return ((seed << 5) | (seed >> 59)) ^ value ^ ((seed >> 2) * 0x9e3779b97f4a7c15ULL);
     }
 
-    operator std::vector<std::vector<double>>() const
+    static std::uint64_t row_hash(const std::vector<std::string>& row, const std::vector<std::size_t>& columns)
     {
-        return to_matrix<double>();
+        std::uint64_t h = 0;
+        for(const auto& c : columns)
+            h = hash_combine(h, hash_string(row[c]));
+        return mix(h);
     }
 
-    operator std::vector<std::vector<std::string>>() const
+    /**
+     * @struct Moments
+     * @brief 数値列の集計途中の値 (要素数・合計・最小・最大・偏差平方和)
+     */
+    struct Moments
     {
-        return to_matrix<std::string>();
+        std::size_t count;
+        double sum;
+        double min;
+        double max;
+        double m2;
+    };
+
+    static bool to_number(const std::string& value, double& result)
+    {
+        if(value.empty())
+            return false;
+        char* end;
+        result = std::strtod(value.c_str(), &end);
+        return end == value.c_str() + value.size() && result == result;
     }
 
-private:
-    std::vector<std::string>  header_;
-    std::vector<std::vector<std::string>> data_;
+    /**
+     * @fn format_number
+     * @brief 数値を読み戻すと同じ値になる最短の桁数で文字列に変換する
+     */
+    static std::string format_number(const double& value)
+    {
+        std::ostringstream ss;
+        for(int precision = std::numeric_limits<double>::digits10; ; precision++)
+        {
+            ss.str("");
+            ss << std::setprecision(precision) << value;
+            if(precision >= std::numeric_limits<double>::max_digits10 || std::strtod(ss.str().c_str(), nullptr) == value)
+                return ss.str();
+        }
+    }
 
-    static std::string concat(const std::vector<std::string>& origin, const std::string& separator)
+    /**
+     * @fn pairwise_sum
+     * @brief f(values[i]) の総和をペアワイズ加算で求める
+     * @note 末端のブロックは4本の独立したアキュムレータで加算し、コンパイラの自動ベクトル化を効かせる。
+     * @n    丸め誤差は O(log n) に抑えられる。
+     */
+    template<typename F>
+    static double pairwise_sum(const double* values, const std::size_t& size, const F& f)
     {
-        std::string result;
-        for (const auto& str : origin)
-            result += str + separator;
-        
-        auto separator_size = separator.size();
-        while(separator_size--)
-            result.pop_back();
-        return result;
+        const std::size_t block = 128;
+        if(size > block)
+        {
+            const std::size_t half = size / 2;
+            return pairwise_sum(values, half, f) + pairwise_sum(values + half, size - half, f);
+        }
+
+        double lane[4] = {0.0, 0.0, 0.0, 0.0};
+        std::size_t i = 0;
+        for(; i + 4 <= size; i += 4)
+        {
+            lane[0] += f(values[i]);
+            lane[1] += f(values[i + 1]);
+            lane[2] += f(values[i + 2]);
+            lane[3] += f(values[i + 3]);
+        }
+        for(; i < size; i++)
+            lane[0] += f(values[i]);
+        return (lane[0] + lane[1]) + (lane[2] + lane[3]);
     }
 
-    static std::vector<std::string> split(const std::string& origin, const std::string& separator, const bool& auto_trim=false)
+    /**
+     * @fn moments
+     * @brief 連続領域に格納された数値列の集計途中値を求める
+     * @note 偏差平方和は平均を求めた後の2パス目で計算する (deviation=falseの場合は省略)。
+     */
+    static Moments moments(const double* values, const std::size_t& size, const bool& deviation)
     {
-        if (origin.empty())
-            return {};
-        if (separator.empty())
-            return {origin};
-        
-        std::vector<std::string> result;
-        std::size_t separator_size = separator.size();
-        std::size_t find_start = 0;
+        Moments result = {size, 0.0, std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(), 0.0};
+        if(size == 0)
+            return result;
 
-        while (true)
+        result.sum = pairwise_sum(values, size, [](const double& x) { return x; });
+
+        double lower[4] = {values[0], values[0], values[0], values[0]};
+        double upper[4] = {values[0], values[0], values[0], values[0]};
+        std::size_t i = 0;
+        for(; i + 4 <= size; i += 4)
         {
-            std::size_t find_position = origin.find(separator, find_start);
-            if (find_position == std::string::npos)
+            for(std::size_t k = 0; k < 4; k++)
             {
-                auto elem = std::string(origin.begin() + find_start, origin.end());
-                if(auto_trim)
-                    result.emplace_back(trim(elem));
-                else
-                    result.emplace_back(elem);
-                break;
+                lower[k] = values[i + k] < lower[k] ? values[i + k] : lower[k];
+                upper[k] = values[i + k] > upper[k] ? values[i + k] : upper[k];
             }
-            auto elem = std::string(origin.begin() + find_start, origin.begin() + find_position);
-            if(auto_trim)
-                result.emplace_back(trim(elem));
-            else
-                result.emplace_back(elem);
-            find_start = find_position + separator_size;
+        }
+        for(; i < size; i++)
+        {
+            lower[0] = values[i] < lower[0] ? values[i] : lower[0];
+            upper[0] = values[i] > upper[0] ? values[i] : upper[0];
+        }
+        result.min = (std::min)((std::min)(lower[0], lower[1]), (std::min)(lower[2], lower[3]));
+        result.max = (std::max)((std::max)(upper[0], upper[1]), (std::max)(upper[2], upper[3]));
+
+        if(deviation)
+        {
+            const double mean = result.sum / size;
+            result.m2 = pairwise_sum(values, size, [mean](const double& x) { return (x - mean) * (x - mean); });
         }
         return result;
     }
 
-    static std::string trim(const std::string& origin)
+    /**
+     * @fn merge_moments
+     * @brief 2つの集計途中値を統合する (偏差平方和はChanらの並列アルゴリズムで統合)
+     */
+    static Moments merge_moments(const Moments& a, const Moments& b)
     {
-        std::string result = origin;
-        const char *whitespaces = " \t\n\r\f\v";
-        auto last_current_pos = result.find_last_not_of(whitespaces);
-        if (last_current_pos == std::string::npos)
+        if(a.count == 0)
+            return b;
+        if(b.count == 0)
+            return a;
+
+        Moments result;
+        result.count = a.count + b.count;
+        result.sum   = a.sum + b.sum;
+        result.min   = (std::min)(a.min, b.min);
+        result.max   = (std::max)(a.max, b.max);
+        const double delta = b.sum / b.count - a.sum / a.count;
+        result.m2    = a.m2 + b.m2 + delta * delta * a.count * b.count / result.count;
+        return result;
+    }
+
+    /**
+     * @fn column_moments
+     * @brief 指定列を数値の連続領域に変換して集計途中値を求める
+     * @note 並列実行時は行を分割し、各スレッドで変換・集計した結果を統合する。
+     */
+    Moments column_moments(const std::size_t& column, const enum Execution& execution, const bool& deviation) const
+    {
+        const std::size_t chunk_size = thread_size(execution, data_.size());
+        const std::size_t chunk      = (data_.size() + chunk_size - 1) / chunk_size;
+        std::vector<Moments> partial(chunk_size, moments(nullptr, 0, false));
+        parallel_for(chunk_size, chunk_size, [&](const std::size_t& begin, const std::size_t& end)
         {
-            result.clear();
-            return result;
+            std::vector<double> values;
+            double value;
+            for(auto k = begin; k < end; k++)
+            {
+                values.clear();
+                const std::size_t last = (std::min)(data_.size(), (k + 1) * chunk);
+                for(auto r = k * chunk; r < last; r++)
+                    if(to_number(data_[r][column], value))
+                        values.push_back(value);
+                partial[k] = moments(values.data(), values.size(), deviation);
+            }
+        });
+
+        Moments result = partial.front();
+        for(std::size_t k = 1; k < partial.size(); k++)
+            result = merge_moments(result, partial[k]);
+        return result;
+    }
+
+    template<typename F>
+    DataFrame aggregate(const enum Execution& execution, const bool& deviation, const F& format) const
+    {
+        std::vector<std::string> result(header_.size());
+        for(std::size_t c = 0; c < header_.size(); c++)
+            result[c] = format(column_moments(c, execution, deviation));
+        return DataFrame(header_, {result});
+    }
+
+    /**
+     * @fn quantiles
+     * @brief 昇順に指定した分位点の値を線形補間で求める (pandasの既定の補間方法と同じ)
+     * @note 全体のソートは行わず、std::nth_element による部分選択で求める。valuesの並び順は変更される。
+     */
+    static std::vector<double> quantiles(std::vector<double>& values, const std::vector<double>& q)
+    {
+        std::vector<double> result;
+        std::size_t start = 0;
+        for(const auto& p : q)
+        {
+            const double position = p * (values.size() - 1);
+            const std::size_t lower = static_cast<std::size_t>(position);
+            std::nth_element(values.begin() + start, values.begin() + lower, values.end());
+            double value = values[lower];
+            if(lower + 1 < values.size() && position > lower)
+                value += (*std::min_element(values.begin() + lower + 1, values.end()) - value) * (position - lower);
+            result.push_back(value);
+            start = lower;
         }
-        result.erase(last_current_pos + 1);
-        result.erase(0, result.find_first_not_of(whitespaces));
         return result;
     }
 
+    static bool is_heap_allocated(const std::string& value)
+    {
+        const auto begin = reinterpret_cast<const char*>(&value);
+        const auto end   = begin + sizeof(std::string);
+        return value.data() < begin || value.data() >= end;
+    }
+
+    static std::size_t allocation_overhead(const std::size_t& bytes)
+    {
+        if(bytes == 0)
+            return 0;
+        const std::size_t header = 8;
+        const std::size_t align  = 16;
+        const std::size_t chunk  = std::max<std::size_t>(32, (bytes + header + align - 1) / align * align);
+        return chunk - bytes;
+    }
+
+    /**
+     * @fn thread_size
+     * @brief 実行モードと処理量から使用するスレッド数を決定する
+     * @note マクロ DATA_FRAME_THREAD_SIZE を定義した場合はハードウェアのスレッド数の代わりにその値を使用する。
+     */
+    static std::size_t thread_size(const enum Execution& execution, const std::size_t& work)
+    {
+        const std::size_t threshold = 1 << 16;
+        if(execution == SEQUENTIAL || (execution == AUTO && work < threshold))
+            return 1;
+#ifdef DATA_FRAME_THREAD_SIZE
+        return DATA_FRAME_THREAD_SIZE;
+#else
+        return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+#endif
+    }
+
+    /**
+     * @fn parallel_for
+     * @brief [0, size) の範囲を分割し、各区間 [begin, end) を別スレッドで処理する
+     * @note スレッド内で発生した例外は全スレッドの終了後に呼出元へ再送出する。
+     */
+    template<typename F>
+    static void parallel_for(const std::size_t& size, const std::size_t& thread_size, const F& func)
+    {
+        const std::size_t n = (std::min)(thread_size, size);
+        if(n <= 1)
+        {
+            if(size > 0)
+                func(std::size_t(0), size);
+            return;
+        }
+
+        const std::size_t chunk = (size + n - 1) / n;
+        std::vector<std::thread> threads;
+        std::vector<std::exception_ptr> errors(n);
+        for(std::size_t i = 0; i < n && i * chunk < size; i++)
+        {
+            const std::size_t begin = i * chunk;
+            const std::size_t end   = (std::min)(size, begin + chunk);
+            threads.emplace_back([&func, &errors, i, begin, end]()
+            {
+                try
+                {
+                    func(begin, end);
+                }
+                catch(...)
+                {
+                    errors[i] = std::current_exception();
+                }
+            });
+        }
+        for(auto& thread : threads)
+            thread.join();
+        for(const auto& error : errors)
+            if(error)
+                std::rethrow_exception(error);
+    }
+
     template<class T, class = void> 
     struct As 
     {
@@ -655,8 +5370,8 @@ private:
         }
     }; 
 
-    explicit DataFrame(const std::vector<std::string>& header, const std::vector<std::vector<std::string>>&& data)
-     : header_(header), data_(std::move(data))
+    explicit DataFrame(std::vector<std::string> header, std::vector<std::vector<std::string>>&& data)
+     : header_(std::move(header)), data_(std::move(data))
     {}
 };
 
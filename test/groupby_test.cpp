@@ -0,0 +1,67 @@
+/**
+ * @file groupby_test.cpp
+ * @brief groupby の集計 (逐次・並列) の確認
+ * @note g++ -std=c++11 -pthread -I.. groupby_test.cpp && ./a.out
+ * @n    並列の経路を必ず通すため、スレッド数を固定してからインクルードする。
+ */
+
+#ifndef DATA_FRAME_THREAD_SIZE
+#define DATA_FRAME_THREAD_SIZE 4
+#endif
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "data_frame.hpp"
+
+static int failure = 0;
+
+static void check(const bool& condition, const std::string& message)
+{
+    if(!condition)
+    {
+        std::cerr << "FAILED: " << message << std::endl;
+        failure++;
+    }
+}
+
+int main()
+{
+    // shop "c" は price が全て空文字のため、数値の要素がないグループとなる
+    const std::string path = "groupby_test.csv";
+    {
+        std::ofstream ofs(path);
+        ofs << "shop,item,price\n";
+        ofs << "a,tea,100\n";
+        ofs << "b,tea,120\n";
+        ofs << "c,cake,\n";
+        ofs << "a,cake,300\n";
+        ofs << "c,tea,\n";
+    }
+    const auto df = DataFrame::read_csv(path);
+    std::remove(path.c_str());
+
+    for(const auto& execution : {DataFrame::SEQUENTIAL, DataFrame::PARALLEL})
+    {
+        const auto result = df.groupby({"shop"}).agg({{"price", DataFrame::SUM}, {"price", DataFrame::MEAN}, {"price", DataFrame::COUNT},
+                                                     {"item", DataFrame::SUM}, {"item", DataFrame::FIRST}}, execution);
+        const auto a = result[result["shop"] == "a"];
+        const auto c = result[result["shop"] == "c"];
+        check(a["price_sum"].as<double>() == 400.0, "sum of numeric group");
+        check(a["price_mean"].as<double>() == 200.0, "mean of numeric group");
+        check(c["price_sum"].as<std::string>().empty(), "sum of group without numeric values must be empty");
+        check(c["price_mean"].as<std::string>().empty(), "mean of group without numeric values must be empty");
+        check(c["price_count"].as<int>() == 0, "count of group without values must be 0");
+        check(a["item_sum"].as<std::string>().empty(), "sum of non-numeric column must be empty");
+        check(c["item_first"].as<std::string>() == "cake", "first of group");
+
+        // DataFrame::sum と同じ結果になる
+        const auto whole = df[df["shop"] == "c"].sum(execution);
+        check(whole["price"].as<std::string>() == c["price_sum"].as<std::string>(), "groupby sum must match DataFrame::sum");
+    }
+
+    if(failure == 0)
+        std::cout << "groupby_test: OK" << std::endl;
+    return failure == 0 ? 0 : 1;
+}
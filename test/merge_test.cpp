@@ -0,0 +1,79 @@
+/**
+ * @file merge_test.cpp
+ * @brief merge の結合アルゴリズム (ハッシュ結合・ソートマージ結合) が同じ結果になることの確認
+ * @note g++ -std=c++11 -pthread -I.. merge_test.cpp && ./a.out
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "data_frame.hpp"
+
+static int failure = 0;
+
+static void check(const bool& condition, const std::string& message)
+{
+    if(!condition)
+    {
+        std::cerr << "FAILED: " << message << std::endl;
+        failure++;
+    }
+}
+
+static std::string dump(const DataFrame& df)
+{
+    const std::string path = "merge_test_output.csv";
+    df.to_csv(path);
+    std::stringstream ss;
+    ss << std::ifstream(path).rdbuf();
+    std::remove(path.c_str());
+    return ss.str();
+}
+
+// キーに数値・文字列・空文字が混在するDataFrameを生成する
+static DataFrame generate(const std::string& path, const std::string& value, const int& rows, const unsigned int& seed)
+{
+    std::mt19937 engine(seed);
+    {
+        std::ofstream ofs(path);
+        ofs << "key," << value << "\n";
+        for(int i = 0; i < rows; i++)
+        {
+            const int key = static_cast<int>(engine() % 40);
+            ofs << (key == 0 ? std::string() : (key < 30 ? std::to_string(key) : "k" + std::to_string(key))) << "," << i << "\n";
+        }
+    }
+    const auto df = DataFrame::read_csv(path);
+    std::remove(path.c_str());
+    return df;
+}
+
+int main()
+{
+    const auto left  = generate("merge_test_left.csv", "x", 3000, 1);
+    const auto right = generate("merge_test_right.csv", "y", 500, 2);
+    const std::vector<DataFrame::Join> hows = {DataFrame::INNER, DataFrame::LEFT, DataFrame::RIGHT, DataFrame::OUTER, DataFrame::SEMI, DataFrame::ANTI};
+
+    for(const auto& how : hows)
+    {
+        const std::string name = "how " + std::to_string(how);
+        // 既定の結合方法は入力の並び順によらずハッシュ結合と同じ行順
+        check(dump(left.merge(right, {"key"}, how)) == dump(left.merge(right, {"key"}, how, DataFrame::HASH_JOIN)), "auto must match hash join (" + name + ")");
+
+        // sort_values の結果はキー順として扱われ、ソートマージ結合でもハッシュ結合と同じ行順になる
+        const auto sorted_left  = left.sort_values({"key"});
+        const auto sorted_right = right.sort_values({"key"});
+        const auto hash = dump(sorted_left.merge(sorted_right, {"key"}, how, DataFrame::HASH_JOIN));
+        check(dump(sorted_left.merge(sorted_right, {"key"}, how)) == hash, "auto must match hash join on sorted input (" + name + ")");
+        if(how != DataFrame::RIGHT && how != DataFrame::OUTER)
+            check(dump(sorted_left.merge(sorted_right, {"key"}, how, DataFrame::SORT_MERGE_JOIN)) == hash, "sort-merge must match hash join on sorted input (" + name + ")");
+    }
+
+    if(failure == 0)
+        std::cout << "merge_test: OK" << std::endl;
+    return failure == 0 ? 0 : 1;
+}
@@ -0,0 +1,74 @@
+/**
+ * @file reduction_test.cpp
+ * @brief 集計メソッド (sum/mean/min/max/var/std) の確認
+ * @note g++ -std=c++11 -pthread -I.. reduction_test.cpp && ./a.out
+ * @n    並列の経路を必ず通すため、スレッド数を固定してからインクルードする。
+ */
+
+#ifndef DATA_FRAME_THREAD_SIZE
+#define DATA_FRAME_THREAD_SIZE 4
+#endif
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "data_frame.hpp"
+
+static int failure = 0;
+
+static void check(const bool& condition, const std::string& message)
+{
+    if(!condition)
+    {
+        std::cerr << "FAILED: " << message << std::endl;
+        failure++;
+    }
+}
+
+static double value(const DataFrame& df, const std::string& column)
+{
+    return df[column].as<double>();
+}
+
+int main()
+{
+    const std::string path = "reduction_test.csv";
+    {
+        std::ofstream ofs(path);
+        ofs << "small,offset,name\n";
+        for(int i = 0; i < 1000000; i++)
+        {
+            // offset列は 1e9 + {4, 7, 13, 16} の繰り返し (母分散は 22.5、単純な1パスの式では桁落ちする)
+            const int pattern[4] = {4, 7, 13, 16};
+            ofs << "0.1," << 1000000000 + pattern[i % 4] << ",n" << i << "\n";
+        }
+    }
+    const auto df = DataFrame::read_csv(path);
+    std::remove(path.c_str());
+
+    // 0.1 を100万回単純に加算すると 1e-6 程度の誤差が出るが、ペアワイズ加算では桁落ちしない
+    double naive = 0.0;
+    for(int i = 0; i < 1000000; i++)
+        naive += 0.1;
+    for(const auto& execution : {DataFrame::SEQUENTIAL, DataFrame::PARALLEL})
+    {
+        const auto sum = df.sum(execution);
+        check(std::fabs(value(sum, "small") - 100000.0) < 1e-8, "pairwise sum must stay within 1e-8");
+        check(std::fabs(value(sum, "small") - 100000.0) < std::fabs(naive - 100000.0), "pairwise sum must be more accurate than naive loop");
+        check(sum["name"].as<std::string>().empty(), "sum of non-numeric column must be empty");
+
+        check(std::fabs(value(df.var(1, execution), "offset") - 22.5 * 1000000 / 999999) < 1e-6, "variance must not suffer from cancellation");
+        check(std::fabs(value(df.std(0, execution), "offset") - std::sqrt(22.5)) < 1e-6, "population std");
+        check(std::fabs(value(df.mean(execution), "offset") - 1000000010.0) < 1e-6, "mean");
+        check(value((df.min)(execution), "offset") == 1000000004.0, "min");
+        check(value((df.max)(execution), "offset") == 1000000016.0, "max");
+        check((df.mean)(execution)["name"].as<std::string>().empty(), "mean of non-numeric column must be empty");
+    }
+    check(df.count()["name"].as<int>() == 1000000, "count");
+
+    if(failure == 0)
+        std::cout << "reduction_test: OK" << std::endl;
+    return failure == 0 ? 0 : 1;
+}
@@ -0,0 +1,101 @@
+/**
+ * @file sort_test.cpp
+ * @brief sort_values の並列実行が逐次実行と同じ安定な並びになることの確認
+ * @note g++ -std=c++11 -pthread -I.. sort_test.cpp && ./a.out
+ * @n    並列の経路を必ず通すため、スレッド数を固定してからインクルードする。
+ */
+
+#ifndef DATA_FRAME_THREAD_SIZE
+#define DATA_FRAME_THREAD_SIZE 4
+#endif
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "data_frame.hpp"
+
+static int failure = 0;
+
+static void check(const bool& condition, const std::string& message)
+{
+    if(!condition)
+    {
+        std::cerr << "FAILED: " << message << std::endl;
+        failure++;
+    }
+}
+
+static std::string dump(const DataFrame& df)
+{
+    const std::string path = "sort_test_output.csv";
+    df.to_csv(path);
+    std::stringstream ss;
+    ss << std::ifstream(path).rdbuf();
+    std::remove(path.c_str());
+    return ss.str();
+}
+
+int main()
+{
+    // 重複の多いキー (数値・文字列・空文字) と、元の行番号を持つ id 列
+    const int rows = 200000;
+    const std::string path = "sort_test.csv";
+    {
+        std::mt19937 engine(0);
+        std::ofstream ofs(path);
+        ofs << "id,number,text\n";
+        for(int i = 0; i < rows; i++)
+        {
+            const int number = static_cast<int>(engine() % 50) - 25;
+            const int text   = static_cast<int>(engine() % 30);
+            ofs << i << "," << (number == 0 ? std::string() : std::to_string(number * 0.5)) << ",t" << text << "\n";
+        }
+    }
+    const auto df = DataFrame::read_csv(path);
+    std::remove(path.c_str());
+
+    const std::vector<std::vector<std::string>> keys = {{"number"}, {"text"}, {"text", "number"}};
+    const std::vector<std::vector<bool>> directions = {{true}, {false}, {true, false}};
+    for(std::size_t k = 0; k < keys.size(); k++)
+    {
+        const auto sequential = df.sort_values(keys[k], directions[k], DataFrame::SEQUENTIAL);
+        const auto parallel   = df.sort_values(keys[k], directions[k], DataFrame::PARALLEL);
+        check(dump(sequential) == dump(parallel), "parallel sort must match sequential sort (key " + std::to_string(k) + ")");
+
+        // 安定性 : キーが等しい行は元の行順 (id の昇順) に並ぶ
+        const auto data = parallel.data();
+        for(std::size_t r = 1; r < data.size(); r++)
+        {
+            bool same = true;
+            for(const auto& column : keys[k])
+            {
+                const std::size_t c = column == "number" ? 1 : 2;
+                same = same && data[r - 1][c] == data[r][c];
+            }
+            if(same && std::stoi(data[r - 1][0]) > std::stoi(data[r][0]))
+            {
+                check(false, "parallel sort must be stable (key " + std::to_string(k) + ")");
+                break;
+            }
+        }
+    }
+
+    // 数値の昇順、空文字は末尾
+    const auto data = df.sort_values({"number"}, true, DataFrame::PARALLEL).data();
+    bool ordered = true;
+    for(std::size_t r = 1; r < data.size(); r++)
+    {
+        if(data[r].at(1).empty())
+            continue;
+        ordered = ordered && !data[r - 1][1].empty() && std::stod(data[r - 1][1]) <= std::stod(data[r][1]);
+    }
+    check(ordered, "numeric keys must be ascending with missing values last");
+
+    if(failure == 0)
+        std::cout << "sort_test: OK" << std::endl;
+    return failure == 0 ? 0 : 1;
+}
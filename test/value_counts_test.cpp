@@ -0,0 +1,63 @@
+/**
+ * @file value_counts_test.cpp
+ * @brief value_counts (厳密値・近似値) の確認
+ * @note g++ -std=c++11 -pthread -I.. value_counts_test.cpp && ./a.out
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "data_frame.hpp"
+
+static int failure = 0;
+
+static void check(const bool& condition, const std::string& message)
+{
+    if(!condition)
+    {
+        std::cerr << "FAILED: " << message << std::endl;
+        failure++;
+    }
+}
+
+int main()
+{
+    // ip "a" が3回、"b" が2回、"c" が1回 (空文字の行は除外)
+    const std::string path = "value_counts_test.csv";
+    {
+        std::ofstream ofs(path);
+        ofs << "ip,count\n";
+        ofs << "a,1\nb,2\na,3\nc,4\n,5\nb,6\na,7\n";
+    }
+    const auto df = DataFrame::read_csv(path);
+    std::remove(path.c_str());
+
+    for(const auto& approximate : {false, true})
+    {
+        const auto counts = df["ip"].value_counts(0, approximate);
+        check(counts.data().at(0).size() == 2, "result columns must be value columns and count");
+        check(counts["ip"][0].as<std::string>() == "a" && counts["count"][0].as<int>() == 3, "most frequent value first");
+        check(counts["ip"][2].as<std::string>() == "c" && counts["count"][2].as<int>() == 1, "least frequent value last");
+    }
+
+    // 既存の列名と重複する場合は例外、列名を指定すれば集計できる
+    bool thrown = false;
+    try
+    {
+        df.value_counts();
+    }
+    catch(const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    check(thrown, "count column colliding with an existing column must throw");
+    const auto named = df.value_counts(0, false, DataFrame::AUTO, "n");
+    check(named.data().at(0).size() == 3, "count column can be renamed");
+    check(named["n"][0].as<int>() == 1 && named["count"].data().size() == 6, "every row is distinct");
+
+    if(failure == 0)
+        std::cout << "value_counts_test: OK" << std::endl;
+    return failure == 0 ? 0 : 1;
+}